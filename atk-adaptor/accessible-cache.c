@@ -25,10 +25,35 @@
 
 #include "accessible-cache.h"
 #include "accessible-register.h"
+#include "accessible-leasing.h"
+#include "accessible-stateset.h"
 #include "bridge.h"
+#include "object.h"
 
 SpiCache *spi_global_cache = NULL;
 
+/*
+ * The cache keeps a log of the latest SPI_CACHE_LOG_MAX changes, each
+ * stamped with a new generation, so that a client which was in sync at
+ * some generation can ask for just what changed since.
+ */
+#define SPI_CACHE_LOG_MAX 8192
+
+/*
+ * ATK_BRIDGE_CACHE_MAX_OBJECTS bounds the cache. Once it is full, the
+ * tree walk adds objects that are not showing without their children.
+ * Objects seen not showing are kept as eviction candidates, and those
+ * that still are not, and were not called by a client in the last
+ * SPI_CACHE_ACCESS_GRACE_S seconds, are evicted with their cached
+ * subtrees, leaves first, until the cache is back to 90% of the bound.
+ * If that cannot be reached the candidates are not looked at again
+ * until there is a new one. Clients are sent RemoveAccessible for
+ * evicted objects and can still call them as they would any uncached
+ * object. Children left out are walked when their parent becomes
+ * showing.
+ */
+#define SPI_CACHE_ACCESS_GRACE_S 30
+
 static gboolean
 child_added_listener (GSignalInvocationHint * signal_hint,
                       guint n_param_values,
@@ -50,6 +75,9 @@ add_subtree (SpiCache *cache, AtkObject * accessible);
 static gboolean
 add_pending_items (gpointer data);
 
+static void
+cache_item_free (gpointer data);
+
 /*---------------------------------------------------------------------------*/
 
 static void
@@ -105,8 +133,23 @@ static void spi_cache_class_init (SpiCacheClass * klass)
 static void
 spi_cache_init (SpiCache * cache)
 {
-  cache->objects = g_hash_table_new (g_direct_hash, g_direct_equal);
+  const gchar *envvar;
+
+  cache->objects = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                          NULL, cache_item_free);
   cache->add_traversal = g_queue_new ();
+  cache->generation = 0;
+  cache->oldest_generation = 0;
+  cache->log = g_queue_new ();
+  cache->updates = g_hash_table_new (g_int64_hash, g_int64_equal);
+  cache->max_objects = 0;
+  cache->offscreen = g_hash_table_new (g_direct_hash, g_direct_equal);
+  cache->evict_blocked = FALSE;
+  cache->populating = TRUE;
+
+  envvar = g_getenv ("ATK_BRIDGE_CACHE_MAX_OBJECTS");
+  if (envvar)
+    cache->max_objects = atoi (envvar);
 
 #ifdef SPI_ATK_DEBUG
   if (g_thread_supported ())
@@ -134,10 +177,17 @@ spi_cache_finalize (GObject * object)
 {
   SpiCache *cache = SPI_CACHE (object);
 
+  if (cache->add_pending_idle)
+    g_source_remove (cache->add_pending_idle);
   while (!g_queue_is_empty (cache->add_traversal))
     g_object_unref (G_OBJECT (g_queue_pop_head (cache->add_traversal)));
   g_queue_free (cache->add_traversal);
   g_hash_table_unref (cache->objects);
+  g_hash_table_unref (cache->offscreen);
+  while (!g_queue_is_empty (cache->log))
+    g_slice_free (SpiCacheChange, g_queue_pop_head (cache->log));
+  g_queue_free (cache->log);
+  g_hash_table_unref (cache->updates);
 
   g_signal_handlers_disconnect_by_func (spi_global_register,
                                         (GCallback) remove_object, cache);
@@ -152,20 +202,262 @@ spi_cache_finalize (GObject * object)
 
 /*---------------------------------------------------------------------------*/
 
+static void
+cache_item_free (gpointer data)
+{
+  SpiCacheItem *item = data;
+
+  if (!item)
+    return;
+
+  g_free (item->name);
+  g_free (item->description);
+  g_free (item->interfaces);
+  g_array_free (item->children, TRUE);
+  g_slice_free (SpiCacheItem, item);
+}
+
+AtkObject *
+spi_cache_item_ref_to_object (guint64 ref)
+{
+  if (ref == 0)
+    return spi_global_app_data->root;
+  return (AtkObject *) spi_register_ref_to_object (spi_global_register, ref);
+}
+
+/*
+ * Returns the reference clients will be given for gobj, registering
+ * and leasing it as sending a reference to it would.
+ */
+static guint64
+cache_item_ref (GObject * gobj)
+{
+  SpiObjectRecord *record;
+
+  record = spi_register_ensure (spi_global_register, gobj);
+  if (!record)
+    return 0;
+
+  if (!record->in_cache)
+    spi_leasing_take (spi_global_leasing, gobj);
+  return spi_register_object_to_ref (gobj);
+}
+
+static void
+cache_item_refresh (SpiCacheItem * item, AtkObject * obj)
+{
+  AtkStateSet *set = NULL;
+  AtkObject *parent;
+  const gchar *itfs[SPI_OBJECT_MAX_INTERFACES];
+  gint i, count;
+
+  if (item->stale & SPI_CACHE_FIELD_NAME)
+    {
+      g_free (item->name);
+      item->name = g_strdup (atk_object_get_name (obj));
+    }
+
+  if (item->stale & SPI_CACHE_FIELD_DESCRIPTION)
+    {
+      g_free (item->description);
+      item->description = g_strdup (atk_object_get_description (obj));
+    }
+
+  if (item->stale & SPI_CACHE_FIELD_ROLE)
+    {
+      item->role =
+        spi_accessible_role_from_atk_role (atk_object_get_role (obj));
+      item->n_interfaces = spi_object_get_interfaces (obj, itfs);
+      g_free (item->interfaces);
+      item->interfaces = g_new (const gchar *, item->n_interfaces);
+      memcpy (item->interfaces, itfs,
+              item->n_interfaces * sizeof (const gchar *));
+    }
+
+  if (item->stale & SPI_CACHE_FIELD_PARENT)
+    {
+      parent = atk_object_get_parent (obj);
+      item->has_parent = (parent != NULL);
+      item->parent = parent ? cache_item_ref (G_OBJECT (parent)) : 0;
+    }
+
+  if (item->stale & (SPI_CACHE_FIELD_STATES | SPI_CACHE_FIELD_CHILDREN))
+    set = atk_object_ref_state_set (obj);
+
+  if (item->stale & SPI_CACHE_FIELD_STATES)
+    spi_atk_state_set_to_dbus_array (set, item->states);
+
+  if (item->stale & SPI_CACHE_FIELD_CHILDREN)
+    {
+      g_array_set_size (item->children, 0);
+      if (!atk_state_set_contains_state (set, ATK_STATE_MANAGES_DESCENDANTS) &&
+          !atk_state_set_contains_state (set, ATK_STATE_DEFUNCT))
+        {
+          count = atk_object_get_n_accessible_children (obj);
+          for (i = 0; i < count; i++)
+            {
+              AtkObject *child = atk_object_ref_accessible_child (obj, i);
+              guint64 ref;
+
+              if (child)
+                {
+                  ref = cache_item_ref (G_OBJECT (child));
+                  g_array_append_val (item->children, ref);
+                  g_object_unref (child);
+                }
+            }
+        }
+    }
+
+  if (set)
+    g_object_unref (set);
+  item->stale = 0;
+}
+
+/*
+ * Objects the item refers to may have gone away without an event, for
+ * instance when their lease ran out.
+ */
+static gboolean
+cache_item_refs_valid (const SpiCacheItem * item)
+{
+  guint i;
+
+  if (item->has_parent && !spi_cache_item_ref_to_object (item->parent))
+    return FALSE;
+
+  for (i = 0; i < item->children->len; i++)
+    if (!spi_cache_item_ref_to_object (g_array_index (item->children,
+                                                      guint64, i)))
+      return FALSE;
+  return TRUE;
+}
+
+/*
+ * Returns what clients should be told about obj, reading from ATK only
+ * what is not known or has changed since it was last read. Objects that
+ * are not cached get a scratch item, valid until the next call.
+ */
+const SpiCacheItem *
+spi_cache_get_item (SpiCache * cache, AtkObject * obj)
+{
+  static SpiCacheItem *scratch = NULL;
+  SpiCacheItem *item = NULL;
+  gpointer value;
+
+  if (cache && g_hash_table_lookup_extended (cache->objects, obj,
+                                             NULL, &value))
+    {
+      item = value;
+      if (!item)
+        {
+          item = g_slice_new0 (SpiCacheItem);
+          item->children = g_array_new (FALSE, FALSE, sizeof (guint64));
+          item->stale = SPI_CACHE_FIELD_ALL;
+          g_hash_table_insert (cache->objects, obj, item);
+        }
+    }
+  else
+    {
+      if (!scratch)
+        {
+          scratch = g_slice_new0 (SpiCacheItem);
+          scratch->children = g_array_new (FALSE, FALSE, sizeof (guint64));
+        }
+      item = scratch;
+      item->stale = SPI_CACHE_FIELD_ALL;
+    }
+
+  if (item->stale)
+    cache_item_refresh (item, obj);
+  if (!cache_item_refs_valid (item))
+    {
+      item->stale = SPI_CACHE_FIELD_PARENT | SPI_CACHE_FIELD_CHILDREN;
+      cache_item_refresh (item, obj);
+    }
+  return item;
+}
+
+/*
+ * Returns the snapshot of a cached object as it stands, without asking
+ * ATK for anything, or NULL if it was never sent. For objects that are
+ * going away.
+ */
+const SpiCacheItem *
+spi_cache_peek_item (SpiCache * cache, GObject * object)
+{
+  if (!cache)
+    return NULL;
+  return g_hash_table_lookup (cache->objects, object);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Appends a change to the log. An update to a ref that already has one
+ * moves that entry to the tail instead, so that a busy object holds a
+ * single entry rather than filling the log. Clients that had seen the
+ * old entry are sent the object again, as they would be for a new one.
+ */
+static void
+log_change (SpiCache * cache, GObject * gobj, SpiCacheChangeKind kind)
+{
+  guint64 ref = spi_register_object_to_ref (gobj);
+  SpiCacheChange *change;
+  GList *link;
+
+  link = g_hash_table_lookup (cache->updates, &ref);
+  if (link && kind == SPI_CACHE_CHANGE_UPDATE)
+    {
+      g_queue_unlink (cache->log, link);
+      g_queue_push_tail_link (cache->log, link);
+      ((SpiCacheChange *) link->data)->generation = ++cache->generation;
+      return;
+    }
+  /* Later updates follow the add or removal */
+  if (link)
+    g_hash_table_remove (cache->updates, &ref);
+
+  change = g_slice_new (SpiCacheChange);
+  change->generation = ++cache->generation;
+  change->kind = kind;
+  change->ref = ref;
+  g_queue_push_tail (cache->log, change);
+  if (kind == SPI_CACHE_CHANGE_UPDATE)
+    g_hash_table_insert (cache->updates, &change->ref, cache->log->tail);
+
+  if (cache->log->length > SPI_CACHE_LOG_MAX)
+    {
+      link = g_queue_peek_head_link (cache->log);
+      change = link->data;
+      if (g_hash_table_lookup (cache->updates, &change->ref) == link)
+        g_hash_table_remove (cache->updates, &change->ref);
+      g_queue_delete_link (cache->log, link);
+      cache->oldest_generation = change->generation;
+      g_slice_free (SpiCacheChange, change);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
 static void
 remove_object (GObject * source, GObject * gobj, gpointer data)
 {
   SpiCache *cache = SPI_CACHE (data);
+  SpiObjectRecord *record = spi_register_lookup (spi_global_register, gobj);
   
-  if (spi_cache_in (cache, gobj))
+  if (record && record->in_cache)
     {
 #ifdef SPI_ATK_DEBUG
   g_debug ("CACHE REM - %s - %d - %s\n", atk_object_get_name (ATK_OBJECT (gobj)),
             atk_object_get_role (ATK_OBJECT (gobj)),
-            spi_register_object_to_path (spi_global_register, gobj));
+            spi_register_object_get_path (spi_global_register, gobj));
 #endif
       g_signal_emit (cache, cache_signals [OBJECT_REMOVED], 0, gobj);
+      log_change (cache, gobj, SPI_CACHE_CHANGE_REMOVE);
       g_hash_table_remove (cache->objects, gobj);
+      g_hash_table_remove (cache->offscreen, gobj);
+      record->in_cache = FALSE;
     }
   else if (g_queue_remove (cache->add_traversal, gobj))
     {
@@ -176,16 +468,22 @@ remove_object (GObject * source, GObject * gobj, gpointer data)
 static void
 add_object (SpiCache * cache, GObject * gobj)
 {
+  SpiObjectRecord *record;
+
   g_return_if_fail (G_IS_OBJECT (gobj));
 
   g_hash_table_insert (cache->objects, gobj, NULL);
+  record = spi_register_lookup (spi_global_register, gobj);
+  if (record)
+    record->in_cache = TRUE;
 
 #ifdef SPI_ATK_DEBUG
   g_debug ("CACHE ADD - %s - %d - %s\n", atk_object_get_name (ATK_OBJECT (gobj)),
             atk_object_get_role (ATK_OBJECT (gobj)),
-            spi_register_object_to_path (spi_global_register, gobj));
+            spi_register_object_get_path (spi_global_register, gobj));
 #endif
 
+  log_change (cache, gobj, SPI_CACHE_CHANGE_ADD);
   g_signal_emit (cache, cache_signals [OBJECT_ADDED], 0, gobj);
 }
 
@@ -238,6 +536,194 @@ append_children (AtkObject * accessible, GQueue * traversal)
     }
 }
 
+static gboolean
+add_pending_slice (SpiCache * cache, gint64 deadline);
+
+static gboolean
+is_showing (AtkObject * accessible)
+{
+  AtkStateSet *set = atk_object_ref_state_set (accessible);
+  gboolean showing;
+
+  showing = set && atk_state_set_contains_state (set, ATK_STATE_SHOWING);
+  if (set)
+    g_object_unref (set);
+  return showing;
+}
+
+static gboolean
+cache_is_full (SpiCache * cache, guint n_pending)
+{
+  return cache->max_objects &&
+         g_hash_table_size (cache->objects) + n_pending >= cache->max_objects;
+}
+
+/*
+ * Makes gobj an eviction candidate for a bounded cache.
+ */
+static void
+note_offscreen (SpiCache * cache, GObject * gobj)
+{
+  if (!cache->max_objects)
+    return;
+
+  g_hash_table_add (cache->offscreen, gobj);
+  cache->evict_blocked = FALSE;
+}
+
+/*
+ * Takes accessible out of a bounded cache. It stays registered, with a
+ * lease, so that clients can go on calling it for a while.
+ */
+static void
+evict_object (SpiCache * cache, GObject * gobj)
+{
+  SpiObjectRecord *record = spi_register_lookup (spi_global_register, gobj);
+  SpiCacheItem *item = g_hash_table_lookup (cache->objects, gobj);
+  AtkObject *parent = NULL;
+
+  if (item && item->has_parent)
+    parent = spi_cache_item_ref_to_object (item->parent);
+  else if (!item)
+    parent = atk_object_get_parent (ATK_OBJECT (gobj));
+
+  g_signal_emit (cache, cache_signals [OBJECT_REMOVED], 0, gobj);
+  log_change (cache, gobj, SPI_CACHE_CHANGE_REMOVE);
+  g_hash_table_remove (cache->objects, gobj);
+  g_hash_table_remove (cache->offscreen, gobj);
+  record->in_cache = FALSE;
+  spi_leasing_take (spi_global_leasing, gobj);
+
+  if (parent)
+    {
+      record = spi_register_lookup (spi_global_register, G_OBJECT (parent));
+      if (record)
+        record->pruned = TRUE;
+    }
+}
+
+/*
+ * Evicts accessible and its cached descendants, children before their
+ * parents, so that clients are never left with an orphan. The children
+ * are taken from the cache item where it knows them.
+ */
+static void
+evict_subtree (SpiCache * cache, AtkObject * accessible)
+{
+  SpiCacheItem *item = g_hash_table_lookup (cache->objects, accessible);
+  guint i;
+
+  if (item && !(item->stale & SPI_CACHE_FIELD_CHILDREN))
+    {
+      for (i = 0; i < item->children->len; i++)
+        {
+          AtkObject *child;
+
+          child = spi_cache_item_ref_to_object (g_array_index (item->children,
+                                                               guint64, i));
+          if (child && spi_cache_in (cache, G_OBJECT (child)))
+            evict_subtree (cache, child);
+        }
+    }
+  else
+    {
+      AtkStateSet *set = atk_object_ref_state_set (accessible);
+      gint count = 0;
+
+      if (!set ||
+          !atk_state_set_contains_state (set, ATK_STATE_MANAGES_DESCENDANTS))
+        count = atk_object_get_n_accessible_children (accessible);
+      if (set)
+        g_object_unref (set);
+
+      for (i = 0; i < count; i++)
+        {
+          AtkObject *child = atk_object_ref_accessible_child (accessible, i);
+
+          if (!child)
+            continue;
+          if (spi_cache_in (cache, G_OBJECT (child)))
+            evict_subtree (cache, child);
+          g_object_unref (child);
+        }
+    }
+
+  evict_object (cache, G_OBJECT (accessible));
+}
+
+static gint
+compare_last_access (gconstpointer a, gconstpointer b)
+{
+  const SpiObjectRecord *ra = *(SpiObjectRecord * const *) a;
+  const SpiObjectRecord *rb = *(SpiObjectRecord * const *) b;
+
+  return (ra->last_access > rb->last_access) -
+         (ra->last_access < rb->last_access);
+}
+
+static void
+evict_offscreen (SpiCache * cache)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+  GPtrArray *candidates;
+  guint32 now, target;
+  guint i;
+
+  if (!cache->max_objects || cache->evict_blocked ||
+      g_hash_table_size (cache->objects) <= cache->max_objects)
+    return;
+
+  now = g_get_monotonic_time () / G_USEC_PER_SEC;
+  candidates = g_ptr_array_new ();
+
+  g_hash_table_iter_init (&iter, cache->offscreen);
+  while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+      SpiObjectRecord *record;
+      gboolean showing;
+
+      record = spi_register_lookup (spi_global_register, key);
+      if (!record || !record->in_cache)
+        {
+          g_hash_table_iter_remove (&iter);
+          continue;
+        }
+      if (record->last_access &&
+          now - record->last_access < SPI_CACHE_ACCESS_GRACE_S)
+        continue;
+
+      value = g_hash_table_lookup (cache->objects, key);
+      if (value && !(((SpiCacheItem *) value)->stale & SPI_CACHE_FIELD_STATES))
+        showing = (((SpiCacheItem *) value)->states[ATSPI_STATE_SHOWING / 32] &
+                   (1 << (ATSPI_STATE_SHOWING % 32))) != 0;
+      else
+        showing = is_showing (ATK_OBJECT (key));
+      /* It becomes a candidate again when its states next change */
+      if (showing)
+        g_hash_table_iter_remove (&iter);
+      else
+        g_ptr_array_add (candidates, record);
+    }
+
+  g_ptr_array_sort (candidates, compare_last_access);
+  target = cache->max_objects - cache->max_objects / 10;
+  for (i = 0;
+       i < candidates->len && g_hash_table_size (cache->objects) > target;
+       i++)
+    {
+      SpiObjectRecord *record = g_ptr_array_index (candidates, i);
+
+      /* Candidates below one evicted earlier went with it */
+      if (record->in_cache)
+        evict_subtree (cache, ATK_OBJECT (record->gobj));
+    }
+
+  if (g_hash_table_size (cache->objects) > target)
+    cache->evict_blocked = TRUE;
+  g_ptr_array_free (candidates, TRUE);
+}
+
 /*
  * Adds a subtree of accessible objects
  * to the cache at the accessible object provided.
@@ -246,6 +732,9 @@ append_children (AtkObject * accessible, GQueue * traversal)
  * registered. A node is considered a leaf
  * if it has the state "manages-descendants"
  * or if it has already been registered.
+ *
+ * A large tree would freeze the application while it is walked, so
+ * only the first slice is done here and the rest from idle callbacks.
  */
 static void
 add_subtree (SpiCache *cache, AtkObject * accessible)
@@ -254,19 +743,40 @@ add_subtree (SpiCache *cache, AtkObject * accessible)
 
   g_object_ref (accessible);
   g_queue_push_tail (cache->add_traversal, accessible);
-  add_pending_items (cache);
+  if (!add_pending_slice (cache,
+                          g_get_monotonic_time () + DROUTE_SLICE_BUDGET_US) &&
+      cache->add_pending_idle == 0)
+    cache->add_pending_idle = g_idle_add (add_pending_items, cache);
 }
 
 static gboolean
 add_pending_items (gpointer data)
 {
   SpiCache *cache = SPI_CACHE (data);
+
+  if (!add_pending_slice (cache,
+                          g_get_monotonic_time () + DROUTE_SLICE_BUDGET_US))
+    return TRUE;
+
+  cache->add_pending_idle = 0;
+  return FALSE;
+}
+
+/*
+ * Walks the pending traversal until it is empty or, if deadline is not
+ * 0, the deadline has passed, then adds the objects seen so far to the
+ * cache, parents before children. Returns TRUE if the walk is complete.
+ */
+static gboolean
+add_pending_slice (SpiCache * cache, gint64 deadline)
+{
   AtkObject *current;
   GQueue *to_add;
 
   to_add = g_queue_new ();
 
-  while (!g_queue_is_empty (cache->add_traversal))
+  while (!g_queue_is_empty (cache->add_traversal) &&
+         (deadline == 0 || g_get_monotonic_time () < deadline))
     {
       AtkStateSet *set;
 
@@ -278,11 +788,25 @@ add_pending_items (gpointer data)
         {
           /* transfer the ref into to_add */
 	  g_queue_push_tail (to_add, current);
+          if (!atk_state_set_contains_state (set, ATK_STATE_SHOWING) &&
+              current != spi_global_app_data->root)
+            note_offscreen (cache, G_OBJECT (current));
           if (!spi_cache_in (cache, G_OBJECT (current)) &&
               !atk_state_set_contains_state  (set, ATK_STATE_MANAGES_DESCENDANTS) &&
               !atk_state_set_contains_state  (set, ATK_STATE_DEFUNCT))
             {
-              append_children (current, cache->add_traversal);
+              if (cache_is_full (cache, to_add->length) &&
+                  current != spi_global_app_data->root &&
+                  !atk_state_set_contains_state (set, ATK_STATE_SHOWING))
+                {
+                  SpiObjectRecord *record;
+
+                  record = spi_register_ensure (spi_global_register,
+                                                G_OBJECT (current));
+                  record->pruned = TRUE;
+                }
+              else
+                append_children (current, cache->add_traversal);
             }
         }
       else
@@ -300,16 +824,20 @@ add_pending_items (gpointer data)
       current = g_queue_pop_head (to_add);
 
       /* Make sure object is registerd so we are notified if it goes away */
-      g_free (spi_register_object_to_path (spi_global_register,
-              G_OBJECT (current)));
+      spi_register_object_get_path (spi_global_register, G_OBJECT (current));
 
       add_object (cache, G_OBJECT(current));
       g_object_unref (G_OBJECT (current));
     }
 
+  evict_offscreen (cache);
+
   g_queue_free (to_add);
-  cache->add_pending_idle = 0;
-  return FALSE;
+  if (!g_queue_is_empty (cache->add_traversal))
+    return FALSE;
+
+  cache->populating = FALSE;
+  return TRUE;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -411,18 +939,51 @@ toplevel_added_listener (AtkObject * accessible,
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * Finishes any pending additions at once, for callers that need the
+ * cache to be complete, such as a client fetching all of it.
+ */
+void
+spi_cache_complete (SpiCache * cache)
+{
+  g_rec_mutex_lock (&cache_mutex);
+
+  add_pending_slice (cache, 0);
+  if (cache->add_pending_idle)
+    {
+      g_source_remove (cache->add_pending_idle);
+      cache->add_pending_idle = 0;
+    }
+
+  g_rec_mutex_unlock (&cache_mutex);
+}
+
 void
 spi_cache_foreach (SpiCache * cache, GHFunc func, gpointer data)
 {
   g_hash_table_foreach (cache->objects, func, data);
 }
 
+/*
+ * Membership is read from the object's register record. Only the root is
+ * cached without being registered, so other unregistered objects are
+ * known not to be in the cache without looking in the table.
+ */
 gboolean
 spi_cache_in (SpiCache * cache, GObject * object)
 {
+  SpiObjectRecord *record;
+
   if (!cache)
     return FALSE;
 
+  record = spi_register_lookup (spi_global_register, object);
+  if (record)
+    return record->in_cache;
+
+  if ((void *) object != (void *) spi_global_app_data->root)
+    return FALSE;
+
   if (g_hash_table_lookup_extended (cache->objects,
                                     object,
                                     NULL,
@@ -432,6 +993,172 @@ spi_cache_in (SpiCache * cache, GObject * object)
     return FALSE;
 }
 
+/*
+ * Brings back an object left out of, or evicted from, a bounded cache
+ * once it can be seen. Its parent was marked pruned when that happened,
+ * and the parent itself may never change, so the object's own state
+ * change has to be enough.
+ */
+static void
+readd_if_showing (SpiCache * cache, GObject * object, SpiCacheField fields)
+{
+  AtkObject *parent;
+  SpiObjectRecord *record;
+
+  if (!(fields & SPI_CACHE_FIELD_STATES) || !cache->max_objects)
+    return;
+
+  parent = atk_object_get_parent (ATK_OBJECT (object));
+  if (!parent || !spi_cache_in (cache, G_OBJECT (parent)))
+    return;
+  /* The root is never registered, so it cannot be marked */
+  if (parent != spi_global_app_data->root)
+    {
+      record = spi_register_lookup (spi_global_register, G_OBJECT (parent));
+      if (!record || !record->pruned)
+        return;
+    }
+
+  if (!is_showing (ATK_OBJECT (object)) ||
+      g_queue_find (cache->add_traversal, object))
+    return;
+
+  g_object_ref (object);
+  g_queue_push_tail (cache->add_traversal, object);
+  if (cache->add_pending_idle == 0)
+    cache->add_pending_idle = g_idle_add (add_pending_items, cache);
+}
+
+/*
+ * Records that the given fields of what clients cache about object
+ * have changed.
+ */
+void
+spi_cache_note_update (SpiCache * cache, GObject * object,
+                       SpiCacheField fields)
+{
+  SpiCacheItem *item;
+
+  if (!spi_cache_in (cache, object))
+    {
+      readd_if_showing (cache, object, fields);
+      return;
+    }
+
+  item = g_hash_table_lookup (cache->objects, object);
+  if (item)
+    item->stale |= fields;
+  log_change (cache, object, SPI_CACHE_CHANGE_UPDATE);
+
+  /* It may have been hidden; evict_offscreen checks */
+  if ((fields & SPI_CACHE_FIELD_STATES) &&
+      object != G_OBJECT (spi_global_app_data->root))
+    note_offscreen (cache, object);
+
+  /* Walk the children left out of a bounded cache once they can be seen */
+  if (fields & SPI_CACHE_FIELD_STATES)
+    {
+      SpiObjectRecord *record;
+
+      record = spi_register_lookup (spi_global_register, object);
+      if (record && record->pruned && is_showing (ATK_OBJECT (object)))
+        {
+          record->pruned = FALSE;
+          append_children (ATK_OBJECT (object), cache->add_traversal);
+          if (cache->add_pending_idle == 0)
+            cache->add_pending_idle = g_idle_add (add_pending_items, cache);
+        }
+    }
+}
+
+static void
+mark_stale_hf (gpointer key, gpointer value, gpointer data)
+{
+  SpiCacheItem *item = value;
+
+  item->stale = SPI_CACHE_FIELD_ALL;
+}
+
+/*
+ * Forgets what the cache knows about its objects, for when changes
+ * went unnoticed because no event listeners were registered. Every item
+ * is read again from ATK when next sent, and clients asking for the
+ * changes since an earlier generation are told it is too old.
+ */
+void
+spi_cache_invalidate (SpiCache * cache)
+{
+  SpiCacheChange *change;
+
+  g_hash_table_foreach (cache->objects, mark_stale_hf, NULL);
+
+  g_hash_table_remove_all (cache->updates);
+  while ((change = g_queue_pop_head (cache->log)))
+    g_slice_free (SpiCacheChange, change);
+  cache->oldest_generation = ++cache->generation;
+}
+
+/*
+ * Calls func for every logged change made after generation, oldest
+ * first. Returns FALSE, without calling func, if some of those changes
+ * have already left the log or generation is from the future.
+ */
+gboolean
+spi_cache_foreach_change_since (SpiCache * cache, guint32 generation,
+                                SpiCacheChangeFunc func, gpointer data)
+{
+  GList *l;
+
+  if (generation < cache->oldest_generation || generation > cache->generation)
+    return FALSE;
+
+  /* Walk back to the first change after generation */
+  for (l = cache->log->tail;
+       l && ((SpiCacheChange *) l->data)->generation > generation;
+       l = l->prev)
+    ;
+  for (l = l ? l->next : cache->log->head; l; l = l->next)
+    func (l->data, data);
+  return TRUE;
+}
+
+typedef struct _CollectData CollectData;
+struct _CollectData
+{
+  GArray *refs;
+  GHashTable *kinds;
+};
+
+static void
+collect_change (const SpiCacheChange * change, gpointer data)
+{
+  CollectData *cd = data;
+  gpointer key = &((SpiCacheChange *) change)->ref;
+
+  if (!g_hash_table_lookup_extended (cd->kinds, key, NULL, NULL))
+    g_array_append_val (cd->refs, change->ref);
+  g_hash_table_insert (cd->kinds, key, GUINT_TO_POINTER (change->kind));
+}
+
+/*
+ * Collapses the changes made after generation to one per object:
+ * appends each changed ref to refs once, in the order they first
+ * changed, and maps it in kinds, an int64 table, to the kind of its
+ * latest change. The keys belong to the log and last until the next
+ * change. Returns FALSE like spi_cache_foreach_change_since.
+ */
+gboolean
+spi_cache_collect_changes_since (SpiCache * cache, guint32 generation,
+                                 GArray * refs, GHashTable * kinds)
+{
+  CollectData cd;
+
+  cd.refs = refs;
+  cd.kinds = kinds;
+  return spi_cache_foreach_change_since (cache, generation,
+                                         collect_change, &cd);
+}
+
 #ifdef SPI_ATK_DEBUG
 void
 spi_cache_print_info (GObject * obj)
@@ -25,6 +25,7 @@
 
 #include <glib.h>
 #include <glib-object.h>
+#include <atk/atk.h>
 
 typedef struct _SpiCache SpiCache;
 typedef struct _SpiCacheClass SpiCacheClass;
@@ -37,6 +38,61 @@ G_BEGIN_DECLS
 #define SPI_IS_CACHE(o)       (G_TYPE_CHECK__INSTANCE_TYPE ((o), SPI_CACHE_TYPE))
 #define SPI_IS_CACHE_CLASS(k) (G_TYPE_CHECK_CLASS_TYPE ((k), SPI_CACHE_TYPE))
 
+typedef enum
+{
+  SPI_CACHE_CHANGE_ADD,
+  SPI_CACHE_CHANGE_UPDATE,
+  SPI_CACHE_CHANGE_REMOVE
+} SpiCacheChangeKind;
+
+/*
+ * An entry in the cache's change log. ref is the register reference of
+ * the object, or 0 for the root, which is not registered.
+ */
+typedef struct _SpiCacheChange SpiCacheChange;
+struct _SpiCacheChange
+{
+  guint32 generation;
+  SpiCacheChangeKind kind;
+  guint64 ref;
+};
+
+typedef void (*SpiCacheChangeFunc) (const SpiCacheChange * change,
+                                    gpointer data);
+
+/* The parts of a cache item that event listeners report changes to */
+typedef enum
+{
+  SPI_CACHE_FIELD_NAME        = 1 << 0,
+  SPI_CACHE_FIELD_DESCRIPTION = 1 << 1,
+  SPI_CACHE_FIELD_ROLE        = 1 << 2,
+  SPI_CACHE_FIELD_PARENT      = 1 << 3,
+  SPI_CACHE_FIELD_CHILDREN    = 1 << 4,
+  SPI_CACHE_FIELD_STATES      = 1 << 5,
+  SPI_CACHE_FIELD_ALL         = (1 << 6) - 1
+} SpiCacheField;
+
+/*
+ * What clients cache about an object, as last read from ATK, so that
+ * it can be sent again without asking ATK. The parent and children are
+ * register references, 0 being the root. The interfaces depend on the
+ * role and are read along with it. Fields in stale are out of date.
+ */
+typedef struct _SpiCacheItem SpiCacheItem;
+struct _SpiCacheItem
+{
+  gchar *name;
+  gchar *description;
+  guint32 role;
+  guint32 states[2];
+  guint64 parent;
+  GArray *children;
+  const gchar **interfaces;
+  guint n_interfaces : 5;
+  guint has_parent : 1;
+  guint stale : 6;
+};
+
 struct _SpiCache
 {
   GObject parent;
@@ -45,7 +101,24 @@ struct _SpiCache
   GQueue *add_traversal;
   gint add_pending_idle;
 
+  /* Set until the initial walk of the tree is complete */
+  gboolean populating;
+
   guint child_added_listener;
+
+  /* Bumped for every change; the log holds the latest changes */
+  guint32 generation;
+  guint32 oldest_generation;
+  GQueue *log;
+  /* The log link of each ref's latest update, which later ones move */
+  GHashTable *updates;
+
+  /* Soft limit on the number of cached objects, or 0 for none */
+  guint max_objects;
+  /* Cached objects last seen not showing, the eviction candidates */
+  GHashTable *offscreen;
+  /* Set when the candidates could not be evicted down to the bound */
+  gboolean evict_blocked;
 };
 
 struct _SpiCacheClass
@@ -63,5 +136,32 @@ spi_cache_foreach (SpiCache * cache, GHFunc func, gpointer data);
 gboolean
 spi_cache_in (SpiCache * cache, GObject * object);
 
+void
+spi_cache_complete (SpiCache * cache);
+
+void
+spi_cache_note_update (SpiCache * cache, GObject * object,
+                       SpiCacheField fields);
+
+void
+spi_cache_invalidate (SpiCache * cache);
+
+const SpiCacheItem *
+spi_cache_get_item (SpiCache * cache, AtkObject * obj);
+
+const SpiCacheItem *
+spi_cache_peek_item (SpiCache * cache, GObject * object);
+
+AtkObject *
+spi_cache_item_ref_to_object (guint64 ref);
+
+gboolean
+spi_cache_foreach_change_since (SpiCache * cache, guint32 generation,
+                                SpiCacheChangeFunc func, gpointer data);
+
+gboolean
+spi_cache_collect_changes_since (SpiCache * cache, guint32 generation,
+                                 GArray * refs, GHashTable * kinds);
+
 G_END_DECLS
 #endif /* ACCESSIBLE_CACHE_H */
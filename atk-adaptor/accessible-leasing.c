@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "accessible-leasing.h"
+#include "accessible-register.h"
 
 #ifdef SPI_ATK_DEBUG
 #include "accessible-cache.h"
@@ -32,20 +33,42 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * An object handed to clients outside the cache is kept alive for at
+ * least LEASE_TIME_S seconds after the latest time it was handed out.
+ *
+ * Each leased object has one lease, holding one ref on it. Taking a
+ * lease on an object that already has one only moves its expiry, so
+ * objects emitting events by the thousand cost no more than any other.
+ *
+ * Leases hang off a timing wheel of WHEEL_SLOTS slots, each covering
+ * WHEEL_TICK_S seconds. A lease sits in the slot of the tick at which
+ * it was due when it was last placed. When that tick comes round, it
+ * is either ended or, if its expiry moved in the meantime, placed in a
+ * later slot. The wheel turns only while there are leases, and then
+ * once per tick, however many leases there are.
+ */
+
 SpiLeasing *spi_global_leasing;
 
-typedef struct _ExpiryElement
+#define LEASE_TIME_S 15
+#define WHEEL_TICK_S 4
+#define WHEEL_SLOTS 8
+
+/* The wheel must reach past the furthest expiry */
+G_STATIC_ASSERT (WHEEL_SLOTS * WHEEL_TICK_S > LEASE_TIME_S + WHEEL_TICK_S);
+
+struct _SpiLease
 {
-  guint expiry_s;
   GObject *object;
-} ExpiryElement;
+  guint32 expiry_s;
+  GList link;
+};
 
 static void spi_leasing_dispose (GObject * object);
 
 static void spi_leasing_finalize (GObject * object);
 
-static void add_expiry_timeout (SpiLeasing * leasing);
-
 /*---------------------------------------------------------------------------*/
 
 G_DEFINE_TYPE (SpiLeasing, spi_leasing, G_TYPE_OBJECT)
@@ -63,7 +86,12 @@ static void spi_leasing_class_init (SpiLeasingClass * klass)
 static void
 spi_leasing_init (SpiLeasing * leasing)
 {
-  leasing->expiry_queue = g_queue_new ();
+  guint i;
+
+  leasing->leases = g_hash_table_new (g_direct_hash, g_direct_equal);
+  leasing->wheel = g_new (GQueue, WHEEL_SLOTS);
+  for (i = 0; i < WHEEL_SLOTS; i++)
+    g_queue_init (&leasing->wheel[i]);
   leasing->expiry_func_id = 0;
 }
 
@@ -74,7 +102,8 @@ spi_leasing_finalize (GObject * object)
 
   if (leasing->expiry_func_id)
     g_source_remove (leasing->expiry_func_id);
-  g_queue_free (leasing->expiry_queue);
+  g_hash_table_destroy (leasing->leases);
+  g_free (leasing->wheel);
   G_OBJECT_CLASS (spi_leasing_parent_class)->finalize (object);
 }
 
@@ -82,126 +111,168 @@ static void
 spi_leasing_dispose (GObject * object)
 {
   SpiLeasing *leasing = SPI_LEASING (object);
+  guint i;
 
-  ExpiryElement *head;
-  while ((head = g_queue_pop_head (leasing->expiry_queue)))
+  for (i = 0; i < WHEEL_SLOTS; i++)
     {
-      g_object_unref (head->object);
-      g_slice_free (ExpiryElement, head);
+      GList *link;
+
+      while ((link = g_queue_pop_head_link (&leasing->wheel[i])))
+        {
+          SpiLease *lease = link->data;
+
+          g_object_unref (lease->object);
+          g_slice_free (SpiLease, lease);
+        }
     }
+  g_hash_table_remove_all (leasing->leases);
+  leasing->n_live = 0;
   G_OBJECT_CLASS (spi_leasing_parent_class)->dispose (object);
 }
 
 /*---------------------------------------------------------------------------*/
 
-/*
-  End the lease on all objects whose expiry time has passed.
- 
-  Check when the next event is and set the next expiry func.
-*/
-static gboolean
-expiry_func (gpointer data)
+static guint32
+now_s (void)
 {
-  SpiLeasing *leasing = SPI_LEASING (data);
-
-  ExpiryElement *head, *current;
-  GTimeVal t;
+  return g_get_monotonic_time () / G_USEC_PER_SEC;
+}
 
-  g_get_current_time (&t);
+/* The first tick at or after expiry_s, so no lease is cut short */
+static guint32
+due_tick (guint32 expiry_s)
+{
+  return (expiry_s + WHEEL_TICK_S - 1) / WHEEL_TICK_S;
+}
 
-  head = g_queue_peek_head (leasing->expiry_queue);
-  while (head != NULL && head->expiry_s <= t.tv_sec)
-    {
-      current = g_queue_pop_head (leasing->expiry_queue);
+static void
+place_lease (SpiLeasing * leasing, SpiLease * lease)
+{
+  g_queue_push_tail_link (&leasing->wheel[due_tick (lease->expiry_s) %
+                                          WHEEL_SLOTS],
+                          &lease->link);
+}
 
+static void
+end_lease (SpiLeasing * leasing, SpiLease * lease)
+{
 #ifdef SPI_ATK_DEBUG
-      g_debug ("REVOKE - ");
-      spi_cache_print_info (current->object);
+  g_debug ("REVOKE - ");
+  spi_cache_print_info (lease->object);
 #endif
 
-      g_object_unref (current->object);
-      g_slice_free (ExpiryElement, current);
+  g_hash_table_remove (leasing->leases, lease->object);
+  leasing->n_live--;
+  leasing->n_expired++;
 
-      head = g_queue_peek_head (leasing->expiry_queue);
-    }
+  /* The last ref may deregister the object, so drop it last */
+  g_object_unref (lease->object);
+  g_slice_free (SpiLease, lease);
+}
 
-  leasing->expiry_func_id = 0;
-  add_expiry_timeout (leasing);
+static gboolean expiry_func (gpointer data);
 
-  return FALSE;
-}
+static void
+start_wheel (SpiLeasing * leasing)
+{
+  if (leasing->expiry_func_id != 0)
+    return;
 
-/*---------------------------------------------------------------------------*/
+  leasing->tick = now_s () / WHEEL_TICK_S;
+  leasing->expiry_func_id = g_timeout_add_seconds (WHEEL_TICK_S,
+                                                   expiry_func, leasing);
+}
 
 /*
-  Checks if an expiry timeout is already scheduled, if so returns.
-  This is becasue events will always be added to the end of the queue.
-  Events are always later in time to previoulsy added events.
-
-  Otherwise calculate the next wake time using the top of the queue
-  and add the next expiry function.
+  Turns the wheel up to the current tick, ending the leases that are
+  due and moving on those whose expiry has been put back.
 
-  This function is called when a lease is added or at the end of the
-  expiry function to add the next expiry timeout.
+  Stops the wheel once no leases are left.
 */
-static void
-add_expiry_timeout (SpiLeasing * leasing)
+static gboolean
+expiry_func (gpointer data)
 {
-  ExpiryElement *elem;
-  GTimeVal t;
-  guint next_expiry;
+  SpiLeasing *leasing = SPI_LEASING (data);
+  guint32 now = now_s ();
+  guint32 tick = now / WHEEL_TICK_S;
+  guint turns = 0;
 
-  if (leasing->expiry_func_id != 0)
-    return;
+  /* After a long stall every slot is looked at once */
+  while (leasing->tick < tick && turns++ < WHEEL_SLOTS)
+    {
+      GQueue due = G_QUEUE_INIT;
+      GList *link;
+
+      leasing->tick++;
+      due = leasing->wheel[leasing->tick % WHEEL_SLOTS];
+      g_queue_init (&leasing->wheel[leasing->tick % WHEEL_SLOTS]);
+
+      while ((link = g_queue_pop_head_link (&due)))
+        {
+          SpiLease *lease = link->data;
+
+          if (lease->expiry_s <= now)
+            end_lease (leasing, lease);
+          else
+            place_lease (leasing, lease);
+        }
+    }
+  leasing->tick = tick;
 
-  elem = (ExpiryElement *) g_queue_peek_head (leasing->expiry_queue);
-  if (elem == NULL)
-    return;
+  if (leasing->n_live > 0)
+    return TRUE;
 
-  /* The current time is implicitly rounded down here by ignoring the us */
-  g_get_current_time (&t);
-  next_expiry = elem->expiry_s - t.tv_sec;
-  leasing->expiry_func_id = g_timeout_add_seconds (next_expiry,
-                                                   expiry_func, leasing);
+  leasing->expiry_func_id = 0;
+  return FALSE;
 }
 
 /*---------------------------------------------------------------------------*/
 
 /*
   The lease time is expected to be in seconds, the rounding is going to be to
-  intervals of 1 second.
+  intervals of WHEEL_TICK_S seconds.
 
   The lease time is going to be rounded up, as the lease time should be
   considered a MINIMUM that the object will be leased for.
 */
-#define LEASE_TIME_S 15
-#define EXPIRY_TIME_S (LEASE_TIME_S + 1)
-
 GObject *
 spi_leasing_take (SpiLeasing * leasing, GObject * object)
 {
-  /*
-     Get the current time.
-     Quantize the time.
-     Add the release event to the queue.
-     Check the next expiry.
-   */
-
-  GTimeVal t;
-  guint expiry_s;
+  SpiLease *lease;
+  SpiObjectRecord *record;
+  guint32 expiry_s;
 
-  ExpiryElement *elem;
+  expiry_s = now_s () + LEASE_TIME_S;
 
-  g_get_current_time (&t);
-  expiry_s = t.tv_sec + EXPIRY_TIME_S;
+  /* Handed out again within the second; the lease already runs as long */
+  record = spi_register_lookup (spi_global_register, object);
+  if (record && record->lease_expiry == expiry_s)
+    return object;
 
-  elem = g_slice_new (ExpiryElement);
-  elem->expiry_s = expiry_s;
-  elem->object = g_object_ref (object);
-
-  g_queue_push_tail (leasing->expiry_queue, elem);
+  lease = g_hash_table_lookup (leasing->leases, object);
+  if (lease)
+    {
+      /* expiry_func moves it on when its slot comes round */
+      lease->expiry_s = expiry_s;
+      leasing->n_renewed++;
+    }
+  else
+    {
+      start_wheel (leasing);
+
+      lease = g_slice_new (SpiLease);
+      lease->object = g_object_ref (object);
+      lease->expiry_s = expiry_s;
+      lease->link.data = lease;
+      lease->link.prev = lease->link.next = NULL;
+      place_lease (leasing, lease);
+      g_hash_table_insert (leasing->leases, object, lease);
+      leasing->n_live++;
+      leasing->n_taken++;
+    }
 
-  add_expiry_timeout (leasing);
+  if (record)
+    record->lease_expiry = expiry_s;
 
 #ifdef SPI_ATK_DEBUG
   g_debug ("LEASE - ");
@@ -29,6 +29,7 @@
 
 typedef struct _SpiLeasing SpiLeasing;
 typedef struct _SpiLeasingClass SpiLeasingClass;
+typedef struct _SpiLease SpiLease;
 
 G_BEGIN_DECLS
 
@@ -42,8 +43,18 @@ struct _SpiLeasing
 {
   GObject parent;
 
-  GQueue *expiry_queue;
+  /* The lease of each leased object, and the wheel they hang off */
+  GHashTable *leases;
+  GQueue *wheel;
+  guint32 tick;
   guint expiry_func_id;
+
+  /* Objects leased now, and leases taken, renewed and ended so far,
+   * written out with the statistics (see ATK_BRIDGE_STATS_FILE) */
+  guint n_live;
+  guint64 n_taken;
+  guint64 n_renewed;
+  guint64 n_expired;
 };
 
 struct _SpiLeasingClass
@@ -0,0 +1,426 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * Copyright 2008 Novell, Inc.
+ * Copyright 2008, 2009 Codethink Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Pushes objects a client is about to ask for.
+ *
+ * Screen readers read trees in two predictable ways: after GetChildren
+ * on a list they ask for the name, role and state of each child, and
+ * after a focus event they walk up the parent chain. Every call the
+ * bridge answers is shown to spi_prefetch_observe, which follows both
+ * patterns per client. Once a client has shown a pattern twice, the next
+ * GetChildren, or the start of the next parent walk, is followed by a
+ * Prefetch signal sent to that client alone, holding the parent, name,
+ * role and states of the objects it will most likely want next.
+ *
+ * Only objects outside the cache are pushed, as clients already know the
+ * rest, and each client has a byte budget refilled over time so that a
+ * wrong guess costs little. Clients opt in by registering for the
+ * "cache:prefetch" event.
+ */
+
+#include <string.h>
+
+#include <atk/atk.h>
+#include <atspi/atspi.h>
+
+#include "accessible-prefetch.h"
+#include "accessible-cache.h"
+#include "accessible-register.h"
+#include "accessible-stateset.h"
+#include "bridge.h"
+#include "object.h"
+
+#define SPI_CACHE_OBJECT_PATH "/org/a11y/atspi/cache"
+
+/* Times a pattern has to be seen before the bridge acts on it */
+#define PREFETCH_CONFIRM 2
+
+/* Reads of one child counted as fetching it, see note_child_read */
+#define PREFETCH_READS_PER_CHILD 2
+
+#define PREFETCH_MAX_ITEMS 32
+
+/* Children of one parent looked at for a Prefetch signal */
+#define PREFETCH_MAX_CHILDREN 128
+
+/* Bytes a client may be sent per second, and at once */
+#define PREFETCH_BUDGET 32768
+
+/* Rough size of an item besides its name: two references and the rest */
+#define PREFETCH_ITEM_OVERHEAD 96
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * What the bridge knows of one client. The objects are kept only to be
+ * compared with later calls, and are never dereferenced: they may have
+ * gone away since.
+ */
+typedef struct _PrefetchClient
+{
+  gconstpointer children_of;    /* last target of GetChildren */
+  gconstpointer last_child;
+  guint child_reads;
+  guint children_hits;
+
+  gconstpointer parent_given;   /* parent last given to the client */
+  guint parent_hits;
+
+  gint64 budget;
+  gint64 budget_time;
+} PrefetchClient;
+
+static GHashTable *clients;
+
+static PrefetchClient *
+get_client (const char *bus_name)
+{
+  PrefetchClient *client;
+
+  if (!clients)
+    clients = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+  client = g_hash_table_lookup (clients, bus_name);
+  if (!client)
+    {
+      client = g_new0 (PrefetchClient, 1);
+      client->budget = PREFETCH_BUDGET;
+      client->budget_time = g_get_monotonic_time ();
+      g_hash_table_insert (clients, g_strdup (bus_name), client);
+    }
+  return client;
+}
+
+static void
+refill_budget (PrefetchClient *client)
+{
+  gint64 now = g_get_monotonic_time ();
+
+  client->budget += (now - client->budget_time) * PREFETCH_BUDGET /
+                    G_USEC_PER_SEC;
+  client->budget = MIN (client->budget, PREFETCH_BUDGET);
+  client->budget_time = now;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * A Prefetch signal being built. Items are (object, parent, name, role,
+ * states), the same fields AddAccessible leads with.
+ */
+typedef struct _PrefetchSignal
+{
+  PrefetchClient *client;
+  DBusMessage *message;
+  DBusMessageIter iter;
+  DBusMessageIter array;
+  guint n_items;
+} PrefetchSignal;
+
+static gboolean
+begin_signal (PrefetchSignal *signal, PrefetchClient *client,
+              const char *bus_name)
+{
+  refill_budget (client);
+  if (client->budget < PREFETCH_ITEM_OVERHEAD)
+    return FALSE;
+
+  signal->client = client;
+  signal->n_items = 0;
+  signal->message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
+                                             ATSPI_DBUS_INTERFACE_CACHE,
+                                             "Prefetch");
+  if (!signal->message)
+    return FALSE;
+  dbus_message_set_destination (signal->message, bus_name);
+  dbus_message_iter_init_append (signal->message, &signal->iter);
+  dbus_message_iter_open_container (&signal->iter, DBUS_TYPE_ARRAY,
+                                    "((so)(so)suau)", &signal->array);
+  return TRUE;
+}
+
+/*
+ * Appends an item for obj unless the budget is spent. If virtual, parent
+ * manages its descendants and the reference is the virtual one
+ * GetChildren gave.
+ */
+static gboolean
+append_item (PrefetchSignal *signal, AtkObject *obj, AtkObject *parent,
+             gboolean virtual)
+{
+  DBusMessageIter iter_struct, iter_sub;
+  dbus_uint32_t states[2];
+  dbus_uint32_t role;
+  const char *name;
+
+  if (signal->n_items >= PREFETCH_MAX_ITEMS ||
+      signal->client->budget < PREFETCH_ITEM_OVERHEAD)
+    return FALSE;
+
+  name = atk_object_get_name (obj);
+  if (!name)
+    name = "";
+  role = spi_accessible_role_from_atk_role (atk_object_get_role (obj));
+  spi_atk_state_to_dbus_array (obj, states);
+
+  dbus_message_iter_open_container (&signal->array, DBUS_TYPE_STRUCT, NULL,
+                                    &iter_struct);
+  if (virtual)
+    spi_object_append_virtual_reference (&iter_struct, parent, obj);
+  else
+    spi_object_append_reference (&iter_struct, obj);
+  if (parent)
+    spi_object_append_reference (&iter_struct, parent);
+  else
+    spi_object_append_null_reference (&iter_struct);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &name);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT32, &role);
+  dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "u",
+                                    &iter_sub);
+  dbus_message_iter_append_basic (&iter_sub, DBUS_TYPE_UINT32, &states[0]);
+  dbus_message_iter_append_basic (&iter_sub, DBUS_TYPE_UINT32, &states[1]);
+  dbus_message_iter_close_container (&iter_struct, &iter_sub);
+  dbus_message_iter_close_container (&signal->array, &iter_struct);
+
+  signal->client->budget -= PREFETCH_ITEM_OVERHEAD + strlen (name);
+  signal->n_items++;
+  return TRUE;
+}
+
+static void
+end_signal (PrefetchSignal *signal, DBusConnection *bus)
+{
+  dbus_message_iter_close_container (&signal->iter, &signal->array);
+  if (signal->n_items)
+    dbus_connection_send (bus, signal->message, NULL);
+  dbus_message_unref (signal->message);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void
+push_children (DBusConnection *bus, const char *bus_name,
+               PrefetchClient *client, AtkObject *parent)
+{
+  PrefetchSignal signal;
+  gboolean virtual;
+  gint count;
+  gint i;
+
+  if (!begin_signal (&signal, client, bus_name))
+    return;
+
+  /* Most children of a huge list are cached or never read */
+  count = MIN (atk_object_get_n_accessible_children (parent),
+               PREFETCH_MAX_CHILDREN);
+  virtual = spi_object_manages_descendants (parent);
+  for (i = 0; i < count; i++)
+    {
+      AtkObject *child = atk_object_ref_accessible_child (parent, i);
+      gboolean more = TRUE;
+
+      if (child && !spi_cache_in (spi_global_cache, G_OBJECT (child)))
+        more = append_item (&signal, child, parent, virtual);
+      if (child)
+        g_object_unref (child);
+      if (!more)
+        break;
+    }
+
+  end_signal (&signal, bus);
+}
+
+/*
+ * Pushes obj and the objects above it, each with its parent, so that
+ * the rest of the walk is answered from the client's cache.
+ */
+static void
+push_ancestors (DBusConnection *bus, const char *bus_name,
+                PrefetchClient *client, AtkObject *obj)
+{
+  PrefetchSignal signal;
+  AtkObject *root = spi_global_app_data->root;
+
+  if (!begin_signal (&signal, client, bus_name))
+    return;
+
+  while (obj && obj != root)
+    {
+      AtkObject *parent = atk_object_get_parent (obj);
+
+      if (!spi_cache_in (spi_global_cache, G_OBJECT (obj)) &&
+          !append_item (&signal, obj, parent, FALSE))
+        break;
+      obj = parent;
+    }
+
+  end_signal (&signal, bus);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static gboolean
+is_child_read (DBusMessage *message, const char *interface,
+               const char *member)
+{
+  const char *iface = NULL;
+  const char *property = NULL;
+
+  if (!g_strcmp0 (interface, ATSPI_DBUS_INTERFACE_ACCESSIBLE))
+    return !g_strcmp0 (member, "GetRole") ||
+           !g_strcmp0 (member, "GetRoleName") ||
+           !g_strcmp0 (member, "GetLocalizedRoleName") ||
+           !g_strcmp0 (member, "GetState");
+
+  if (g_strcmp0 (interface, DBUS_INTERFACE_PROPERTIES) ||
+      g_strcmp0 (member, "Get") ||
+      !dbus_message_get_args (message, NULL, DBUS_TYPE_STRING, &iface,
+                              DBUS_TYPE_STRING, &property, DBUS_TYPE_INVALID))
+    return FALSE;
+
+  return !g_strcmp0 (iface, ATSPI_DBUS_INTERFACE_ACCESSIBLE) &&
+         (!g_strcmp0 (property, "Name") ||
+          !g_strcmp0 (property, "Description"));
+}
+
+static gboolean
+is_parent_read (DBusMessage *message, const char *interface,
+                const char *member)
+{
+  const char *iface = NULL;
+  const char *property = NULL;
+
+  if (g_strcmp0 (interface, DBUS_INTERFACE_PROPERTIES) ||
+      g_strcmp0 (member, "Get") ||
+      !dbus_message_get_args (message, NULL, DBUS_TYPE_STRING, &iface,
+                              DBUS_TYPE_STRING, &property, DBUS_TYPE_INVALID))
+    return FALSE;
+
+  return !g_strcmp0 (iface, ATSPI_DBUS_INTERFACE_ACCESSIBLE) &&
+         !g_strcmp0 (property, "Parent");
+}
+
+/*
+ * A child of the last GetChildren counts as fetched once it has been
+ * read twice in a row, say its name and then its role, and the pattern
+ * is seen once two children have been fetched.
+ */
+static void
+note_child_read (PrefetchClient *client, AtkObject *obj)
+{
+  if (!client->children_of ||
+      (gconstpointer) atk_object_get_parent (obj) != client->children_of)
+    return;
+
+  if ((gconstpointer) obj != client->last_child)
+    {
+      client->last_child = obj;
+      client->child_reads = 0;
+    }
+  if (++client->child_reads != PREFETCH_READS_PER_CHILD)
+    return;
+
+  if (client->children_hits < PREFETCH_CONFIRM)
+    client->children_hits++;
+}
+
+/*
+ * Asking for the parent of the parent just given continues a walk.
+ * Anything else may start one, which is when the walk is pushed.
+ */
+static void
+note_parent_read (DBusConnection *bus, const char *bus_name,
+                  PrefetchClient *client, AtkObject *obj)
+{
+  AtkObject *parent = atk_object_get_parent (obj);
+
+  if (client->parent_given && (gconstpointer) obj == client->parent_given)
+    {
+      if (client->parent_hits < PREFETCH_CONFIRM)
+        client->parent_hits++;
+    }
+  else if (client->parent_hits >= PREFETCH_CONFIRM && parent)
+    push_ancestors (bus, bus_name, client, parent);
+
+  client->parent_given = parent;
+}
+
+void
+spi_prefetch_observe (DBusConnection * bus, DBusMessage * message,
+                      void * user_data)
+{
+  const char *bus_name = dbus_message_get_sender (message);
+  const char *interface = dbus_message_get_interface (message);
+  const char *member = dbus_message_get_member (message);
+  PrefetchClient *client;
+  GObject *gobj;
+  AtkObject *obj;
+
+  /* Peer-to-peer clients have no name to register events under */
+  if (!bus_name || !interface || !member)
+    return;
+  /* Keep nothing about, and parse nothing from, clients not opted in */
+  if (!spi_atk_client_wants_prefetch (bus_name))
+    return;
+
+  gobj = spi_register_path_to_object (spi_global_register,
+                                      dbus_message_get_path (message));
+  if (!gobj || !ATK_IS_OBJECT (gobj))
+    return;
+  obj = ATK_OBJECT (gobj);
+  client = get_client (bus_name);
+
+  if (!g_strcmp0 (interface, ATSPI_DBUS_INTERFACE_ACCESSIBLE) &&
+      !g_strcmp0 (member, "GetChildren"))
+    {
+      client->children_of = obj;
+      client->last_child = NULL;
+      client->child_reads = 0;
+      if (client->children_hits >= PREFETCH_CONFIRM)
+        push_children (bus, bus_name, client, obj);
+    }
+  else if (is_child_read (message, interface, member))
+    note_child_read (client, obj);
+  else if (is_parent_read (message, interface, member))
+    note_parent_read (bus, bus_name, client, obj);
+}
+
+void
+spi_prefetch_forget_client (const char * bus_name)
+{
+  if (clients)
+    g_hash_table_remove (clients, bus_name);
+}
+
+void
+spi_prefetch_shutdown (void)
+{
+  if (clients)
+    {
+      g_hash_table_destroy (clients);
+      clients = NULL;
+    }
+}
+
+/*END------------------------------------------------------------------------*/
@@ -37,8 +37,29 @@
  * path for it. The D-Bus object paths used have a standard prefix
  * (SPI_ATK_OBJECT_PATH_PREFIX). Appended to this prefix is a string
  * representation of an integer reference. So to access an AtkObject 
- * remotely we keep a Hashtable that maps the given reference to 
- * the AtkObject pointer. An object in this hash table is said to be 'registered'.
+ * remotely we keep an array of records that maps the given reference to 
+ * the AtkObject pointer. An object in this array is said to be 'registered'.
+ *
+ * The low 32 bits of a reference are the slot index and the high 32 bits
+ * the generation of the slot. Freed slots are reused, and bumping the
+ * generation on every free makes paths handed out for the previous
+ * occupant stop resolving. The first generation is 0, so most paths are
+ * just the slot index.
+ *
+ * The record in the slot is also where the rest of the bridge keeps its
+ * per-object state (see SpiObjectRecord). Records are allocated in pages
+ * that never move, so a record pointer can be held across registrations.
+ *
+ * Children of containers that manage their descendants, such as the cells
+ * of a huge table, are not registered when handed out. They are given a
+ * virtual path instead, the container's reference followed by a number
+ * naming the child, "<ref>/<id>". The register only keeps a weak pointer
+ * to such a child, so the path resolves for as long as the child lives
+ * and never to another object. The last VIRTUAL_CHILDREN_MAX children
+ * handed out or resolved are held, so that a toolkit creating cells on
+ * demand does not drop them while they are being used. A virtual child
+ * keeps its path when it is referred to again, for instance by an event,
+ * unless it has been registered, which ends the virtual path.
  *
  * The architecture of AT-SPI dbus is such that AtkObjects are not
  * remotely reference counted. This means that we need to keep track of
@@ -51,10 +72,34 @@
 #define SPI_ATK_OBJECT_PATH_PREFIX  "/org/a11y/atspi/accessible/"
 #define SPI_ATK_OBJECT_PATH_ROOT "root"
 
-#define SPI_ATK_OBJECT_REFERENCE_TEMPLATE SPI_ATK_OBJECT_PATH_PREFIX "%d"
+#define SPI_ATK_OBJECT_REFERENCE_TEMPLATE SPI_ATK_OBJECT_PATH_PREFIX "%" G_GUINT64_FORMAT
+
+#define REF_SLOT(ref)       ((guint32) ((ref) & G_MAXUINT32))
+#define REF_GENERATION(ref) ((guint32) ((ref) >> 32))
+#define MAKE_REF(slot, generation) (((guint64) (generation) << 32) | (slot))
 
 #define SPI_DBUS_ID "spi-dbus-id"
 
+#define RECORDS_PER_PAGE 1024
+
+#define VIRTUAL_CHILDREN_MAX 256
+
+typedef struct _VirtualChild
+{
+  GObject *container;
+  /* Weak, and also a reference of ours while held */
+  GObject *child;
+  guint64 id;
+  gchar *path;
+  gboolean held;
+  GList link;
+} VirtualChild;
+
+#define RECORD_AT(reg, index) \
+  (&((SpiObjectRecord *) g_ptr_array_index ((reg)->pages,                \
+                                            (index) / RECORDS_PER_PAGE)) \
+     [(index) % RECORDS_PER_PAGE])
+
 SpiRegister *spi_global_register = NULL;
 
 static const gchar * spi_register_root_path = SPI_ATK_OBJECT_PATH_PREFIX SPI_ATK_OBJECT_PATH_ROOT;
@@ -112,8 +157,14 @@ static void spi_register_class_init (SpiRegisterClass * klass)
 static void
 spi_register_init (SpiRegister * reg)
 {
-  reg->ref2ptr = g_hash_table_new (g_direct_hash, g_direct_equal);
-  reg->reference_counter = 0;
+  reg->pages = g_ptr_array_new_with_free_func (g_free);
+  reg->virtual_children = g_queue_new ();
+  reg->virtual_by_id = g_hash_table_new (g_int64_hash, g_int64_equal);
+  reg->virtual_by_child = g_hash_table_new (g_direct_hash, g_direct_equal);
+  reg->virtual_serial = 0;
+  /* Slot 0 is never handed out, so a reference of 0 means unregistered */
+  reg->n_slots = 1;
+  reg->free_slot = 0;
 }
 
 static void
@@ -125,64 +176,242 @@ deregister_object (gpointer data, GObject * gobj)
 }
 
 static void
-spi_register_remove_weak_ref (gpointer key, gpointer val, gpointer reg)
+virtual_child_gone (gpointer data, GObject * gobj);
+
+/*
+ * Forgets a virtual child, so that its path no longer resolves.
+ */
+static void
+virtual_child_drop (SpiRegister * reg, VirtualChild * vc, gboolean alive)
+{
+  g_hash_table_remove (reg->virtual_by_id, &vc->id);
+  g_hash_table_remove (reg->virtual_by_child, vc->child);
+  if (alive)
+    g_object_weak_unref (vc->child, virtual_child_gone, reg);
+  if (vc->held)
+    {
+      g_queue_unlink (reg->virtual_children, &vc->link);
+      g_object_unref (vc->child);
+    }
+  g_free (vc->path);
+  g_slice_free (VirtualChild, vc);
+}
+
+static void
+virtual_child_gone (gpointer data, GObject * gobj)
 {
-  g_object_weak_unref (val, deregister_object, reg);
+  SpiRegister *reg = SPI_REGISTER (data);
+  VirtualChild *vc = g_hash_table_lookup (reg->virtual_by_child, gobj);
+
+  /* A held child cannot go away, so there is no reference to drop */
+  if (vc)
+    virtual_child_drop (reg, vc, FALSE);
 }
 
 static void
 spi_register_finalize (GObject * object)
 {
   SpiRegister *reg = SPI_REGISTER (object);
+  GHashTableIter iter;
+  gpointer value;
+  guint32 i;
 
-  g_hash_table_foreach (reg->ref2ptr, spi_register_remove_weak_ref, reg);
-  g_hash_table_unref (reg->ref2ptr);
+  g_hash_table_iter_init (&iter, reg->virtual_by_child);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      g_hash_table_iter_steal (&iter);
+      virtual_child_drop (reg, value, TRUE);
+    }
+  g_hash_table_destroy (reg->virtual_by_id);
+  g_hash_table_destroy (reg->virtual_by_child);
+  g_queue_free (reg->virtual_children);
+
+  for (i = 1; i < reg->n_slots; i++)
+    {
+      SpiObjectRecord *record = RECORD_AT (reg, i);
+
+      if (record->gobj)
+        g_object_weak_unref (record->gobj, deregister_object, reg);
+      g_free (record->path);
+    }
+  g_ptr_array_free (reg->pages, TRUE);
 
   G_OBJECT_CLASS (spi_register_parent_class)->finalize (object);
 }
 
 /*---------------------------------------------------------------------------*/
 
+static gchar *
+ref_to_path (guint64 ref);
+
 /*
  * Each AtkObject must be asssigned a D-Bus path (Reference)
  *
- * This function provides an integer reference for a new
- * AtkObject.
- *
- * TODO: Make this reference a little more unique, this is shoddy.
+ * This function takes a free slot for a new AtkObject, reusing
+ * the most recently freed one if there is any.
  */
-static guint
-assign_reference (SpiRegister * reg)
+static guint32
+assign_slot (SpiRegister * reg, GObject * gobj)
 {
-  reg->reference_counter++;
-  /* Reference of 0 not allowed as used as direct key in hash table */
-  if (reg->reference_counter == 0)
-    reg->reference_counter++;
-  return reg->reference_counter;
+  SpiObjectRecord *record;
+  guint32 index;
+
+  if (reg->free_slot)
+    {
+      index = reg->free_slot;
+      record = RECORD_AT (reg, index);
+      reg->free_slot = record->next_free;
+    }
+  else
+    {
+      index = reg->n_slots++;
+      if (index / RECORDS_PER_PAGE >= reg->pages->len)
+        g_ptr_array_add (reg->pages,
+                         g_new0 (SpiObjectRecord, RECORDS_PER_PAGE));
+      record = RECORD_AT (reg, index);
+    }
+
+  record->gobj = gobj;
+  record->next_free = 0;
+  record->path = ref_to_path (MAKE_REF (index, record->generation));
+  return index;
+}
+
+/*
+ * Clears everything but the generation, which moves on so that
+ * references to the old occupant no longer resolve.
+ */
+static void
+release_slot (SpiRegister * reg, guint32 index)
+{
+  SpiObjectRecord *record = RECORD_AT (reg, index);
+  guint32 generation = record->generation;
+
+  g_free (record->path);
+  memset (record, 0, sizeof (SpiObjectRecord));
+  record->generation = generation + 1;
+  record->next_free = reg->free_slot;
+  reg->free_slot = index;
 }
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * Returns the slot of the object, or 0 if it is not registered.
+ *
+ * The slot index is kept on the object. It is only trusted if the
+ * slot still holds the object.
+ */
+static guint32
+object_to_slot (SpiRegister * reg, GObject * gobj)
+{
+  guint32 index = GPOINTER_TO_UINT (g_object_get_data (gobj, SPI_DBUS_ID));
+
+  if (index == 0 || index >= reg->n_slots || RECORD_AT (reg, index)->gobj != gobj)
+    return 0;
+  return index;
+}
+
 /*
  * Returns the reference of the object, or 0 if it is not registered.
  */
-static guint
-object_to_ref (GObject * gobj)
+static guint64
+object_to_ref (SpiRegister * reg, GObject * gobj)
 {
-  return GPOINTER_TO_INT (g_object_get_data (gobj, SPI_DBUS_ID));
+  guint32 index = object_to_slot (reg, gobj);
+
+  if (index == 0)
+    return 0;
+  return MAKE_REF (index, RECORD_AT (reg, index)->generation);
 }
 
 /*
  * Converts the Accessible object reference to its D-Bus object path
  */
 static gchar *
-ref_to_path (guint ref)
+ref_to_path (guint64 ref)
 {
   return g_strdup_printf (SPI_ATK_OBJECT_REFERENCE_TEMPLATE, ref);
 }
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * Makes vc the most recently used virtual child, holding it and letting
+ * go of the least recently used one if too many are held.
+ */
+static void
+hold_virtual_child (SpiRegister * reg, VirtualChild * vc)
+{
+  if (vc->held)
+    {
+      g_queue_unlink (reg->virtual_children, &vc->link);
+      g_queue_push_head_link (reg->virtual_children, &vc->link);
+      return;
+    }
+
+  g_object_ref (vc->child);
+  vc->held = TRUE;
+  g_queue_push_head_link (reg->virtual_children, &vc->link);
+  if (reg->virtual_children->length > VIRTUAL_CHILDREN_MAX)
+    {
+      VirtualChild *oldest = g_queue_pop_tail_link (reg->virtual_children)->data;
+
+      /* Still known, but only for as long as something else keeps it */
+      oldest->held = FALSE;
+      g_object_unref (oldest->child);
+    }
+}
+
+/*
+ * Drops the virtual children of a container that is going away.
+ */
+static void
+forget_virtual_children (SpiRegister * reg, GObject * container)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_hash_table_iter_init (&iter, reg->virtual_by_child);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      VirtualChild *vc = value;
+
+      if (vc->container == container)
+        {
+          g_hash_table_iter_steal (&iter);
+          virtual_child_drop (reg, vc, TRUE);
+        }
+    }
+}
+
+/*
+ * Resolves the "<id>" part of a virtual path below container.
+ */
+static GObject *
+virtual_path_to_object (SpiRegister * reg, GObject * container,
+                        const char *path)
+{
+  VirtualChild *vc;
+  guint64 id;
+  gchar *end;
+
+  if (!g_ascii_isdigit (*path))
+    return NULL;
+  id = g_ascii_strtoull (path, &end, 10);
+  if (*end != '\0')
+    return NULL;
+
+  vc = g_hash_table_lookup (reg->virtual_by_id, &id);
+  if (!vc || vc->container != container)
+    return NULL;
+
+  hold_virtual_child (reg, vc);
+  return vc->child;
+}
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * Callback for when a registered AtkObject is destroyed.
  *
@@ -192,21 +421,26 @@ ref_to_path (guint ref)
 void
 spi_register_deregister_object (SpiRegister *reg, GObject *gobj, gboolean unref)
 {
-  guint ref;
+  guint32 index;
 
-  ref = object_to_ref (gobj);
-  if (ref != 0)
+  index = object_to_slot (reg, gobj);
+  if (index != 0)
     {
       g_signal_emit (reg,
                      register_signals [OBJECT_DEREGISTERED],
                      0,
                      gobj);
       if (unref)
-        g_object_weak_unref (gobj, deregister_object, reg);
-      g_hash_table_remove (reg->ref2ptr, GINT_TO_POINTER (ref));
+        {
+          g_object_weak_unref (gobj, deregister_object, reg);
+          g_object_set_data (gobj, SPI_DBUS_ID, NULL);
+        }
+      if (RECORD_AT (reg, index)->has_virtual_children)
+        forget_virtual_children (reg, gobj);
+      release_slot (reg, index);
 
 #ifdef SPI_ATK_DEBUG
-      g_debug ("DEREG  - %d", ref);
+      g_debug ("DEREG  - %u", index);
 #endif
     }
 }
@@ -214,17 +448,25 @@ spi_register_deregister_object (SpiRegister *reg, GObject *gobj, gboolean unref)
 static void
 register_object (SpiRegister * reg, GObject * gobj)
 {
-  guint ref;
+  guint32 index;
   g_return_if_fail (G_IS_OBJECT (gobj));
 
-  ref = assign_reference (reg);
+  /* Registering a virtual child gives it its one identity */
+  if (g_hash_table_size (reg->virtual_by_child))
+    {
+      VirtualChild *vc = g_hash_table_lookup (reg->virtual_by_child, gobj);
+
+      if (vc)
+        virtual_child_drop (reg, vc, TRUE);
+    }
 
-  g_hash_table_insert (reg->ref2ptr, GINT_TO_POINTER (ref), gobj);
-  g_object_set_data (G_OBJECT (gobj), SPI_DBUS_ID, GINT_TO_POINTER (ref));
+  index = assign_slot (reg, gobj);
+
+  g_object_set_data (G_OBJECT (gobj), SPI_DBUS_ID, GUINT_TO_POINTER (index));
   g_object_weak_ref (G_OBJECT (gobj), deregister_object, reg);
 
 #ifdef SPI_ATK_DEBUG
-  g_debug ("REG  - %d", ref);
+  g_debug ("REG  - %u", index);
 #endif
 
   g_signal_emit (reg, register_signals [OBJECT_REGISTERED], 0, gobj);
@@ -240,8 +482,9 @@ register_object (SpiRegister * reg, GObject * gobj)
 GObject *
 spi_register_path_to_object (SpiRegister * reg, const char *path)
 {
-  guint index;
-  void *data;
+  SpiObjectRecord *record;
+  guint64 ref;
+  gchar *end;
 
   g_return_val_if_fail (path, NULL);
 
@@ -255,12 +498,21 @@ spi_register_path_to_object (SpiRegister * reg, const char *path)
   if (!g_strcmp0 (SPI_ATK_OBJECT_PATH_ROOT, path))
     return G_OBJECT (spi_global_app_data->root);
 
-  index = atoi (path);
-  data = g_hash_table_lookup (reg->ref2ptr, GINT_TO_POINTER (index));
-  if (data)
-    return G_OBJECT(data);
-  else
+  if (!g_ascii_isdigit (*path))
+    return NULL;
+  ref = g_ascii_strtoull (path, &end, 10);
+  if ((*end != '\0' && *end != '/') ||
+      REF_SLOT (ref) == 0 || REF_SLOT (ref) >= reg->n_slots)
     return NULL;
+
+  record = RECORD_AT (reg, REF_SLOT (ref));
+  if (record->generation != REF_GENERATION (ref) || !record->gobj)
+    return NULL;
+
+  if (*end == '/')
+    return virtual_path_to_object (reg, record->gobj, end + 1);
+  record->last_access = g_get_monotonic_time () / G_USEC_PER_SEC;
+  return record->gobj;
 }
 
 GObject *
@@ -269,43 +521,192 @@ spi_global_register_path_to_object (const char * path)
   return spi_register_path_to_object (spi_global_register, path);
 }
 
+/*
+ * Returns the record of a registered object, or NULL if the object
+ * is not registered.
+ */
+SpiObjectRecord *
+spi_register_lookup (SpiRegister * reg, GObject * gobj)
+{
+  guint32 index;
+
+  if (reg == NULL || gobj == NULL)
+    return NULL;
+
+  index = object_to_slot (reg, gobj);
+  return index ? RECORD_AT (reg, index) : NULL;
+}
+
+/*
+ * Returns the record of the object, registering it first if need be.
+ *
+ * The root object is never registered, so NULL is returned for it.
+ */
+SpiObjectRecord *
+spi_register_ensure (SpiRegister * reg, GObject * gobj)
+{
+  guint32 index;
+
+  if (gobj == NULL || (void *)gobj == (void *)spi_global_app_data->root)
+    return NULL;
+
+  index = object_to_slot (reg, gobj);
+  if (!index)
+    {
+      register_object (reg, gobj);
+      index = object_to_slot (reg, gobj);
+    }
+
+  return index ? RECORD_AT (reg, index) : NULL;
+}
+
 /*
  * Used to lookup a D-Bus path from the GObject.
  * 
  * If the objects is not already registered, 
  * this function will register it.
+ *
+ * The path belongs to the register and stays valid until the object
+ * is deregistered, so it can be marshalled without copying.
  */
-gchar *
-spi_register_object_to_path (SpiRegister * reg, GObject * gobj)
+const gchar *
+spi_register_object_get_path (SpiRegister * reg, GObject * gobj)
 {
-  guint ref;
-
-  if (gobj == NULL)
-    return NULL;
+  SpiObjectRecord *record;
 
   /* Map the root object to the root path. */
-  if ((void *)gobj == (void *)spi_global_app_data->root)
-    return g_strdup (spi_register_root_path);
+  if (gobj != NULL && (void *)gobj == (void *)spi_global_app_data->root)
+    return spi_register_root_path;
+
+  record = spi_register_ensure (reg, gobj);
+  return record ? record->path : NULL;
+}
+
+/*
+ * Returns the virtual path of child, a child of container, giving it one
+ * if it has none yet. The container is registered but child is not.
+ * NULL is returned if the container cannot be registered.
+ *
+ * The path belongs to the register and is only valid until the next
+ * call into the register, so it should be marshalled straight away.
+ */
+const gchar *
+spi_register_virtual_child_to_path (SpiRegister * reg, GObject * container,
+                                    GObject * child)
+{
+  SpiObjectRecord *record;
+  VirtualChild *vc;
 
-  ref = object_to_ref (gobj);
-  if (!ref)
+  vc = g_hash_table_lookup (reg->virtual_by_child, child);
+  if (!vc)
     {
-      register_object (reg, gobj);
-      ref = object_to_ref (gobj);
+      record = spi_register_ensure (reg, container);
+      if (!record)
+        return NULL;
+      record->has_virtual_children = TRUE;
+
+      vc = g_slice_new0 (VirtualChild);
+      vc->container = container;
+      vc->child = child;
+      vc->id = ++reg->virtual_serial;
+      vc->path = g_strdup_printf ("%s/%" G_GUINT64_FORMAT, record->path,
+                                  vc->id);
+      vc->link.data = vc;
+      g_object_weak_ref (child, virtual_child_gone, reg);
+      g_hash_table_insert (reg->virtual_by_id, &vc->id, vc);
+      g_hash_table_insert (reg->virtual_by_child, child, vc);
     }
 
-  if (!ref)
+  hold_virtual_child (reg, vc);
+  return vc->path;
+}
+
+/*
+ * Returns the virtual path of child if it has one, or NULL. The path is
+ * borrowed as for spi_register_virtual_child_to_path.
+ */
+const gchar *
+spi_register_virtual_child_get_path (SpiRegister * reg, GObject * child)
+{
+  VirtualChild *vc;
+
+  if (g_hash_table_size (reg->virtual_by_child) == 0)
     return NULL;
-  else
-    return ref_to_path (ref);
+
+  vc = g_hash_table_lookup (reg->virtual_by_child, child);
+  if (!vc)
+    return NULL;
+  hold_virtual_child (reg, vc);
+  return vc->path;
 }
 
-guint
+/*
+ * As spi_register_object_get_path, but returns a copy of the path.
+ */
+gchar *
+spi_register_object_to_path (SpiRegister * reg, GObject * gobj)
+{
+  return g_strdup (spi_register_object_get_path (reg, gobj));
+}
+
+guint64
 spi_register_object_to_ref (GObject * gobj)
 {
-  return object_to_ref (gobj);
+  return object_to_ref (spi_global_register, gobj);
+}
+
+/*
+ * Returns the object with the given reference, or NULL if that
+ * reference is no longer valid.
+ */
+GObject *
+spi_register_ref_to_object (SpiRegister * reg, guint64 ref)
+{
+  SpiObjectRecord *record;
+
+  if (REF_SLOT (ref) == 0 || REF_SLOT (ref) >= reg->n_slots)
+    return NULL;
+
+  record = RECORD_AT (reg, REF_SLOT (ref));
+  if (record->generation != REF_GENERATION (ref))
+    return NULL;
+  return record->gobj;
+}
+
+/*
+ * Returns the path a reference had, whether or not it is still valid.
+ */
+gchar *
+spi_register_ref_to_path (guint64 ref)
+{
+  return ref_to_path (ref);
 }
   
+/*
+ * Returns the record of the first registered object in a slot at or
+ * after *slot, and moves *slot past it; returns NULL and sets *slot
+ * to 0 once there are none left. Starting from 1 visits every object
+ * in slot order.
+ */
+SpiObjectRecord *
+spi_register_next_record (SpiRegister *reg, guint32 *slot)
+{
+  guint32 i;
+
+  for (i = MAX (*slot, 1); i < reg->n_slots; i++)
+    {
+      SpiObjectRecord *record = RECORD_AT (reg, i);
+
+      if (record->gobj)
+        {
+          *slot = i + 1;
+          return record;
+        }
+    }
+  *slot = 0;
+  return NULL;
+}
+
 /*
  * Gets the path that indicates the accessible desktop object.
  * This object is logically located on the registry daemon and not
@@ -29,6 +29,7 @@
 
 typedef struct _SpiRegister SpiRegister;
 typedef struct _SpiRegisterClass SpiRegisterClass;
+typedef struct _SpiObjectRecord SpiObjectRecord;
 
 G_BEGIN_DECLS
 
@@ -38,12 +39,52 @@ G_BEGIN_DECLS
 #define SPI_IS_REGISTER(o)       (G_TYPE_CHECK__INSTANCE_TYPE ((o), SPI_REGISTER_TYPE))
 #define SPI_IS_REGISTER_CLASS(k) (G_TYPE_CHECK_CLASS_TYPE ((k), SPI_REGISTER_TYPE))
 
+/*
+ * Everything the bridge keeps about a registered object, so that marshalling
+ * a reference or handling an event needs one lookup rather than one per
+ * table. Objects live in a dense array of these, indexed by the low 32 bits
+ * of their reference. The high bits hold the generation of the slot, which
+ * changes each time the slot is freed, so that a stale path never resolves
+ * to whichever object took the slot over.
+ *
+ * Everything but the generation is cleared when the object is deregistered.
+ */
+struct _SpiObjectRecord
+{
+  GObject *gobj;
+  guint32 generation;
+  /* Next slot in the free list, while gobj is NULL */
+  guint32 next_free;
+  /* The D-Bus path, built once when the object is registered */
+  gchar *path;
+
+  /* Monotonic second the latest lease ends, or 0 if never leased */
+  guint32 lease_expiry;
+
+  /* Monotonic second a client last called the object, or 0 */
+  guint32 last_access;
+
+  guint in_cache : 1;
+  /* Some virtual child of this container may be held */
+  guint has_virtual_children : 1;
+  /* Its children were left out of, or evicted from, a bounded cache */
+  guint pruned : 1;
+};
+
 struct _SpiRegister
 {
   GObject parent;
 
-  GHashTable * ref2ptr;
-  guint reference_counter;
+  GPtrArray * pages;
+  guint32 n_slots;
+  guint32 free_slot;
+
+  /* Children given virtual paths, by id and by object, and the most
+   * recently used of them, which are held */
+  GHashTable * virtual_by_id;
+  GHashTable * virtual_by_child;
+  GQueue * virtual_children;
+  guint64 virtual_serial;
 };
 
 struct _SpiRegisterClass
@@ -66,8 +107,30 @@ spi_global_register_path_to_object (const char * path);
 gchar *
 spi_register_object_to_path (SpiRegister * reg, GObject * gobj);
 
-guint
+const gchar *
+spi_register_object_get_path (SpiRegister * reg, GObject * gobj);
+
+SpiObjectRecord *
+spi_register_lookup (SpiRegister * reg, GObject * gobj);
+
+SpiObjectRecord *
+spi_register_ensure (SpiRegister * reg, GObject * gobj);
+
+const gchar *
+spi_register_virtual_child_to_path (SpiRegister * reg, GObject * container,
+                                    GObject * child);
+
+const gchar *
+spi_register_virtual_child_get_path (SpiRegister * reg, GObject * child);
+
+guint64
 spi_register_object_to_ref (GObject * gobj);
+
+GObject *
+spi_register_ref_to_object (SpiRegister * reg, guint64 ref);
+
+gchar *
+spi_register_ref_to_path (guint64 ref);
   
 gchar *
 spi_register_root_object_path ();
@@ -75,6 +138,9 @@ spi_register_root_object_path ();
 void
 spi_register_deregister_object (SpiRegister *reg, GObject *gobj, gboolean unref);
 
+SpiObjectRecord *
+spi_register_next_record (SpiRegister *reg, guint32 *slot);
+
 /*---------------------------------------------------------------------------*/
 
 #endif /* ACCESSIBLE_REGISTER_H */
@@ -0,0 +1,189 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * Copyright 2008 Novell, Inc.
+ * Copyright 2008, 2009 Codethink Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * The objects removed from the cache in one main loop pass, kept with
+ * their path, parent and children as last sent to clients, as they are
+ * deregistered right after.
+ *
+ * When a window or container is destroyed its whole branch leaves the
+ * cache in one pass. A removed object whose children as last sent were
+ * all removed too, and are complete themselves, is "complete". Sorting
+ * the removals gives each complete object with children whose parent is
+ * not complete, as the root of a removed subtree, and the other objects
+ * not below one of those. The descendants of a subtree root need not be
+ * mentioned to clients.
+ */
+
+#include "accessible-removals.h"
+
+typedef enum
+{
+  REMOVED_UNKNOWN,
+  REMOVED_CHECKING,
+  REMOVED_COMPLETE,
+  REMOVED_PARTIAL
+} RemovedState;
+
+typedef struct _RemovedObject RemovedObject;
+struct _RemovedObject
+{
+  guint64 ref;
+  gchar *path;
+  guint64 parent;
+  gboolean has_parent;
+  GArray *children;
+  RemovedState state;
+};
+
+struct _SpiRemovals
+{
+  GPtrArray *removes;
+  GHashTable *removed_refs;
+};
+
+static void
+removed_object_free (gpointer data)
+{
+  RemovedObject *removed = data;
+
+  g_free (removed->path);
+  g_array_free (removed->children, TRUE);
+  g_slice_free (RemovedObject, removed);
+}
+
+SpiRemovals *
+spi_removals_new (void)
+{
+  SpiRemovals *removals = g_slice_new (SpiRemovals);
+
+  removals->removes = g_ptr_array_new_with_free_func (removed_object_free);
+  removals->removed_refs = g_hash_table_new (g_int64_hash, g_int64_equal);
+  return removals;
+}
+
+void
+spi_removals_free (SpiRemovals * removals)
+{
+  g_hash_table_unref (removals->removed_refs);
+  g_ptr_array_free (removals->removes, TRUE);
+  g_slice_free (SpiRemovals, removals);
+}
+
+/*
+ * Records the removal of the object with ref, taking ownership of its
+ * path. item is what was last sent about it, or NULL if nothing was.
+ */
+void
+spi_removals_add (SpiRemovals * removals, guint64 ref, gchar * path,
+                  const SpiCacheItem * item)
+{
+  RemovedObject *removed = g_slice_new0 (RemovedObject);
+
+  removed->ref = ref;
+  removed->path = path;
+  removed->children = g_array_new (FALSE, FALSE, sizeof (guint64));
+  if (item)
+    {
+      removed->parent = item->parent;
+      removed->has_parent = item->has_parent;
+      g_array_append_vals (removed->children, item->children->data,
+                           item->children->len);
+    }
+
+  /* Clients may know of children that were never sent as its children */
+  if (!item || (item->stale & SPI_CACHE_FIELD_CHILDREN))
+    removed->state = REMOVED_PARTIAL;
+  g_ptr_array_add (removals->removes, removed);
+  g_hash_table_insert (removals->removed_refs, &removed->ref, removed);
+}
+
+/*
+ * Whether the children the object was last sent with were all removed
+ * too, and are complete themselves.
+ */
+static gboolean
+removed_is_complete (SpiRemovals * removals, RemovedObject * removed)
+{
+  guint i;
+
+  if (removed->state == REMOVED_UNKNOWN)
+    {
+      removed->state = REMOVED_CHECKING;
+      for (i = 0; i < removed->children->len; i++)
+        {
+          RemovedObject *child;
+
+          child = g_hash_table_lookup (removals->removed_refs,
+                                       &g_array_index (removed->children,
+                                                       guint64, i));
+          if (!child || !removed_is_complete (removals, child))
+            break;
+        }
+      if (i < removed->children->len)
+        removed->state = REMOVED_PARTIAL;
+      else
+        removed->state = REMOVED_COMPLETE;
+    }
+  /* A cycle is not a subtree */
+  return removed->state == REMOVED_COMPLETE;
+}
+
+/*
+ * Appends the paths of the subtree roots to subtrees and of the other
+ * objects to mention to singles, in the order they were removed. The
+ * paths belong to removals and last until it is cleared.
+ */
+void
+spi_removals_sort (SpiRemovals * removals, GPtrArray * subtrees,
+                   GPtrArray * singles)
+{
+  guint i;
+
+  for (i = 0; i < removals->removes->len; i++)
+    {
+      RemovedObject *removed = g_ptr_array_index (removals->removes, i);
+      RemovedObject *parent = NULL;
+
+      if (removed->has_parent)
+        parent = g_hash_table_lookup (removals->removed_refs,
+                                      &removed->parent);
+      if (parent && removed_is_complete (removals, parent))
+        continue;
+
+      if (removed_is_complete (removals, removed) &&
+          removed->children->len > 0)
+        g_ptr_array_add (subtrees, removed->path);
+      else
+        g_ptr_array_add (singles, removed->path);
+    }
+}
+
+void
+spi_removals_clear (SpiRemovals * removals)
+{
+  g_hash_table_remove_all (removals->removed_refs);
+  g_ptr_array_set_size (removals->removes, 0);
+}
+
+/*END------------------------------------------------------------------------*/
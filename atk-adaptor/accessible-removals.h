@@ -0,0 +1,53 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * Copyright 2008 Novell, Inc.
+ * Copyright 2008, 2009 Codethink Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef ACCESSIBLE_REMOVALS_H
+#define ACCESSIBLE_REMOVALS_H
+
+#include <glib.h>
+
+#include "accessible-cache.h"
+
+typedef struct _SpiRemovals SpiRemovals;
+
+G_BEGIN_DECLS
+
+SpiRemovals *
+spi_removals_new (void);
+
+void
+spi_removals_free (SpiRemovals * removals);
+
+void
+spi_removals_add (SpiRemovals * removals, guint64 ref, gchar * path,
+                  const SpiCacheItem * item);
+
+void
+spi_removals_sort (SpiRemovals * removals, GPtrArray * subtrees,
+                   GPtrArray * singles);
+
+void
+spi_removals_clear (SpiRemovals * removals);
+
+G_END_DECLS
+#endif /* ACCESSIBLE_REMOVALS_H */
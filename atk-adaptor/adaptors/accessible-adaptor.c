@@ -31,6 +31,7 @@
 #include "accessible-stateset.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 #include <string.h>
 
 static dbus_bool_t
@@ -181,7 +182,7 @@ impl_GetChildAtIndex (DBusConnection * bus,
       g_free (child_name);
     }
   child = atk_object_ref_accessible_child (object, i);
-  reply = spi_object_return_reference (message, child);
+  reply = spi_object_return_child_reference (message, object, child);
   g_object_unref (child);
 
   return reply;
@@ -194,12 +195,14 @@ impl_GetChildren (DBusConnection * bus,
   AtkObject *object = (AtkObject *) user_data;
   gint i;
   gint count;
+  gboolean virtual;
   DBusMessage *reply;
   DBusMessageIter iter, iter_array;
 
   g_return_val_if_fail (ATK_IS_OBJECT (user_data),
                         droute_not_yet_handled_error (message));
   count = atk_object_get_n_accessible_children (object);
+  virtual = spi_object_manages_descendants (object);
   reply = dbus_message_new_method_return (message);
   if (!reply)
     goto oom;
@@ -210,7 +213,10 @@ impl_GetChildren (DBusConnection * bus,
   for (i = 0; i < count; i++)
     {
       AtkObject *child = atk_object_ref_accessible_child (object, i);
-      spi_object_append_reference (&iter_array, child); 
+      if (virtual)
+        spi_object_append_virtual_reference (&iter_array, object, child);
+      else
+        spi_object_append_reference (&iter_array, child); 
       if (child)
         g_object_unref (child);
     }
@@ -524,16 +530,16 @@ impl_GetInterfaces (DBusConnection * bus,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetChildAtIndex, "GetChildAtIndex"},
-  {impl_GetChildren, "GetChildren"},
-  {impl_GetIndexInParent, "GetIndexInParent"},
-  {impl_GetRelationSet, "GetRelationSet"},
-  {impl_GetRole, "GetRole"},
-  {impl_GetRoleName, "GetRoleName"},
-  {impl_GetLocalizedRoleName, "GetLocalizedRoleName"},
-  {impl_GetState, "GetState"},
-  {impl_GetAttributes, "GetAttributes"},
-  {impl_GetApplication, "GetApplication"},
+  {impl_GetChildAtIndex, "GetChildAtIndex", SPI_ACCESSIBLE_GET_CHILD_AT_INDEX_SIGNATURE},
+  {impl_GetChildren, "GetChildren", SPI_ACCESSIBLE_GET_CHILDREN_SIGNATURE},
+  {impl_GetIndexInParent, "GetIndexInParent", SPI_ACCESSIBLE_GET_INDEX_IN_PARENT_SIGNATURE},
+  {impl_GetRelationSet, "GetRelationSet", SPI_ACCESSIBLE_GET_RELATION_SET_SIGNATURE},
+  {impl_GetRole, "GetRole", SPI_ACCESSIBLE_GET_ROLE_SIGNATURE},
+  {impl_GetRoleName, "GetRoleName", SPI_ACCESSIBLE_GET_ROLE_NAME_SIGNATURE},
+  {impl_GetLocalizedRoleName, "GetLocalizedRoleName", SPI_ACCESSIBLE_GET_LOCALIZED_ROLE_NAME_SIGNATURE},
+  {impl_GetState, "GetState", SPI_ACCESSIBLE_GET_STATE_SIGNATURE},
+  {impl_GetAttributes, "GetAttributes", SPI_ACCESSIBLE_GET_ATTRIBUTES_SIGNATURE},
+  {impl_GetApplication, "GetApplication", SPI_ACCESSIBLE_GET_APPLICATION_SIGNATURE},
   {impl_GetInterfaces, "GetInterfaces"},
   {NULL, NULL}
 };
@@ -29,6 +29,7 @@
 #include "spi-dbus.h"
 
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_NActions (DBusMessageIter * iter, void *user_data)
@@ -228,17 +229,18 @@ impl_DoAction (DBusConnection * bus, DBusMessage * message, void *user_data)
 }
 
 DRouteMethod methods[] = {
-  {impl_get_description, "GetDescription"}
+  {impl_get_description, "GetDescription", SPI_ACTION_GET_DESCRIPTION_SIGNATURE}
   ,
-  {impl_get_name, "GetName"}
+  {impl_get_name, "GetName", SPI_ACTION_GET_NAME_SIGNATURE}
   ,
-  {impl_get_localized_name, "GetLocalizedName"}
+  {impl_get_localized_name, "GetLocalizedName", SPI_ACTION_GET_LOCALIZED_NAME_SIGNATURE}
   ,
-  {impl_get_keybinding, "GetKeyBinding"}
+  {impl_get_keybinding, "GetKeyBinding", SPI_ACTION_GET_KEY_BINDING_SIGNATURE}
   ,
-  {impl_GetActions, "GetActions"}
+  {impl_GetActions, "GetActions", SPI_ACTION_GET_ACTIONS_SIGNATURE}
   ,
-  {impl_DoAction, "DoAction"}
+  {impl_DoAction, "DoAction", SPI_ACTION_DO_ACTION_SIGNATURE,
+   DROUTE_METHOD_SENDS_REPLY}
   ,
   {NULL, NULL}
 };
@@ -31,9 +31,12 @@
 #include "spi-dbus.h"
 #include "accessible-stateset.h"
 #include "accessible-cache.h"
+#include "accessible-register.h"
+#include "accessible-removals.h"
 #include "bridge.h"
 #include "object.h"
-#include "introspection.h"
+#include "introspection-bridge.h"
+#include "method-args.h"
 
 /* TODO - This should possibly be a common define */
 #define SPI_OBJECT_PREFIX "/org/a11y/atspi"
@@ -63,159 +66,416 @@
 /*---------------------------------------------------------------------------*/
 
 /*
- * Marshals the given AtkObject into the provided D-Bus iterator.
+ * Cache items are written either through DBusMessageIter or, for large
+ * GetItems replies, straight into a DRouteWire. An ItemWriter hides
+ * which, so that both are written by the one write_cache_item.
+ */
+
+/* Containers an item nests: item, array, reference */
+#define ITEM_WRITER_DEPTH 3
+
+typedef struct _ItemWriter ItemWriter;
+struct _ItemWriter
+{
+  DRouteWire *wire;
+  DBusMessageIter *base;
+  DBusMessageIter iters[ITEM_WRITER_DEPTH];
+  gsize arrays[ITEM_WRITER_DEPTH];
+  guint depth;
+};
+
+static DBusMessageIter *
+writer_iter (ItemWriter * writer)
+{
+  return writer->depth ? &writer->iters[writer->depth - 1] : writer->base;
+}
+
+static void
+writer_open_struct (ItemWriter * writer)
+{
+  if (writer->wire)
+    droute_wire_open_struct (writer->wire);
+  else
+    dbus_message_iter_open_container (writer_iter (writer), DBUS_TYPE_STRUCT,
+                                      NULL, &writer->iters[writer->depth]);
+  writer->depth++;
+}
+
+static void
+writer_open_array (ItemWriter * writer, const char *signature,
+                   guint alignment)
+{
+  if (writer->wire)
+    writer->arrays[writer->depth] = droute_wire_open_array (writer->wire,
+                                                            alignment);
+  else
+    dbus_message_iter_open_container (writer_iter (writer), DBUS_TYPE_ARRAY,
+                                      signature,
+                                      &writer->iters[writer->depth]);
+  writer->depth++;
+}
+
+static void
+writer_close (ItemWriter * writer, gboolean array)
+{
+  writer->depth--;
+  if (!writer->wire)
+    dbus_message_iter_close_container (writer_iter (writer),
+                                       &writer->iters[writer->depth]);
+  else if (array)
+    droute_wire_close_array (writer->wire, writer->arrays[writer->depth]);
+}
+
+/* type is DBUS_TYPE_STRING or DBUS_TYPE_OBJECT_PATH */
+static void
+writer_append_string (ItemWriter * writer, int type, const char *value)
+{
+  if (writer->wire)
+    droute_wire_append_string (writer->wire, value);
+  else
+    dbus_message_iter_append_basic (writer_iter (writer), type, &value);
+}
+
+static void
+writer_append_uint32 (ItemWriter * writer, dbus_uint32_t value)
+{
+  if (writer->wire)
+    droute_wire_append_uint32 (writer->wire, value);
+  else
+    dbus_message_iter_append_basic (writer_iter (writer), DBUS_TYPE_UINT32,
+                                    &value);
+}
+
+static void
+writer_append_reference (ItemWriter * writer, AtkObject * obj)
+{
+  if (writer->wire)
+    spi_object_wire_append_reference (writer->wire, obj);
+  else
+    spi_object_append_reference (writer_iter (writer), obj);
+}
+
+static void
+writer_append_null_reference (ItemWriter * writer)
+{
+  if (writer->wire)
+    spi_object_wire_append_null_reference (writer->wire);
+  else
+    spi_object_append_null_reference (writer_iter (writer));
+}
+
+static void
+writer_append_desktop_reference (ItemWriter * writer)
+{
+  if (writer->wire)
+    spi_object_wire_append_desktop_reference (writer->wire);
+  else
+    spi_object_append_desktop_reference (writer_iter (writer));
+}
+
+/*
+ * Appends a reference given as "<bus name>:<path>", as plugs and sockets
+ * keep them. Returns FALSE, appending nothing, if id is not one.
+ */
+static gboolean
+writer_append_id_reference (ItemWriter * writer, const char *id)
+{
+  gchar *bus_name, *path;
+
+  if (!id)
+    return FALSE;
+
+  bus_name = g_strdup (id);
+  path = g_utf8_strchr (bus_name + 1, -1, ':');
+  if (path)
+    {
+      *(path++) = '\0';
+      writer_open_struct (writer);
+      writer_append_string (writer, DBUS_TYPE_STRING, bus_name);
+      writer_append_string (writer, DBUS_TYPE_OBJECT_PATH, path);
+      writer_close (writer, FALSE);
+    }
+  g_free (bus_name);
+  return path != NULL;
+}
+
+/*
+ * Marshals the given AtkObject.
  *
  * The object is marshalled including all its client side cache data.
  * The format of the structure is (o(so)a(so)assusau).
+ *
+ * The data comes from the object's cache snapshot, so ATK is only asked
+ * for what changed since the object was last sent.
  */
 static void
+write_cache_item (AtkObject * obj, ItemWriter * writer)
+{
+  const SpiCacheItem *item;
+  guint i;
+
+  item = spi_cache_get_item (spi_global_cache, obj);
+
+  writer_open_struct (writer);
+
+  /* Marshall object path */
+  writer_append_reference (writer, obj);
+
+  /* Marshall application */
+  writer_append_reference (writer, spi_global_app_data->root);
+
+  /* Marshall parent */
+  if (item->has_parent)
+    writer_append_reference (writer,
+                             spi_cache_item_ref_to_object (item->parent));
+  /* TODO, move in to a 'Plug' wrapper. */
+  else if (ATK_IS_PLUG (obj))
+    {
+      if (!writer_append_id_reference (writer,
+                                       g_object_get_data (G_OBJECT (obj),
+                                                          "dbus-plug-parent")))
+        writer_append_null_reference (writer);
+    }
+  else if (item->role != ATSPI_ROLE_APPLICATION)
+    writer_append_null_reference (writer);
+  else
+    writer_append_desktop_reference (writer);
+
+  /* Marshall children */
+  writer_open_array (writer, SPI_OBJECT_REFERENCE_SIGNATURE, 8);
+  for (i = 0; i < item->children->len; i++)
+    {
+      guint64 ref = g_array_index (item->children, guint64, i);
+
+      writer_append_reference (writer, spi_cache_item_ref_to_object (ref));
+    }
+  if (ATK_IS_SOCKET (obj) && atk_socket_is_occupied (ATK_SOCKET (obj)))
+    writer_append_id_reference (writer, ATK_SOCKET (obj)->embedded_plug_id);
+  writer_close (writer, TRUE);
+
+  /* Marshall interfaces */
+  writer_open_array (writer, DBUS_TYPE_STRING_AS_STRING, 4);
+  for (i = 0; i < item->n_interfaces; i++)
+    writer_append_string (writer, DBUS_TYPE_STRING, item->interfaces[i]);
+  writer_close (writer, TRUE);
+
+  /* Marshall name, role and description */
+  writer_append_string (writer, DBUS_TYPE_STRING,
+                        item->name ? item->name : "");
+  writer_append_uint32 (writer, item->role);
+  writer_append_string (writer, DBUS_TYPE_STRING,
+                        item->description ? item->description : "");
+
+  /* Marshall state set */
+  writer_open_array (writer, DBUS_TYPE_UINT32_AS_STRING, 4);
+  for (i = 0; i < 2; i++)
+    writer_append_uint32 (writer, item->states[i]);
+  writer_close (writer, TRUE);
+
+  writer_close (writer, FALSE);
+}
+
+/* Appends a cache item to the array iterator data */
+static void
 append_cache_item (AtkObject * obj, gpointer data)
+{
+  ItemWriter writer = { NULL, data };
+
+  write_cache_item (obj, &writer);
+}
+
+static void
+wire_append_cache_item (AtkObject * obj, DRouteWire * wire)
+{
+  ItemWriter writer = { wire, NULL };
+
+  write_cache_item (obj, &writer);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * The compact encoding of a cache item, for clients that opt in. Full
+ * items repeat the bus name in every reference and spell out every
+ * interface name, which is most of their size.
+ *
+ * The format of the structure is (ttatususau): the object, its parent,
+ * its children, its interfaces, name, role, description and state set.
+ *
+ * References are the numbers the object paths end in, 0 standing for
+ * the root, and the bus name is the sender of the message. A parent of
+ * COMPACT_NO_REF is either none or outside the application: the desktop
+ * for the application object, or the socket a plug is embedded in. The
+ * plug embedded in a socket is left out of its children likewise.
+ * Clients needing those links can ask GetItemsForSubtree for the full
+ * item.
+ *
+ * Interfaces are a bitmask over compact_interfaces, which clients get
+ * from GetItemsCompact.
+ *
+ * Only the fields given, SpiCacheField bits plus COMPACT_FIELD_INTERFACES,
+ * are filled in. The others are sent as 0 or empty.
+ */
+
+#define SPI_CACHE_COMPACT_ITEM_SIGNATURE "(" \
+                                           DBUS_TYPE_UINT64_AS_STRING \
+                                           DBUS_TYPE_UINT64_AS_STRING \
+                                           DBUS_TYPE_ARRAY_AS_STRING \
+                                             DBUS_TYPE_UINT64_AS_STRING \
+                                           DBUS_TYPE_UINT32_AS_STRING \
+                                           DBUS_TYPE_STRING_AS_STRING \
+                                           DBUS_TYPE_UINT32_AS_STRING \
+                                           DBUS_TYPE_STRING_AS_STRING \
+                                           DBUS_TYPE_ARRAY_AS_STRING \
+                                             DBUS_TYPE_UINT32_AS_STRING \
+                                         ")"
+
+#define COMPACT_NO_REF G_MAXUINT64
+
+#define COMPACT_FIELD_INTERFACES (1 << 6)
+#define COMPACT_FIELDS_ALL (SPI_CACHE_FIELD_ALL | COMPACT_FIELD_INTERFACES)
+
+/* Everything spi_object_get_interfaces can return */
+static const gchar *compact_interfaces[] = {
+  ATSPI_DBUS_INTERFACE_ACCESSIBLE,
+  ATSPI_DBUS_INTERFACE_ACTION,
+  ATSPI_DBUS_INTERFACE_APPLICATION,
+  ATSPI_DBUS_INTERFACE_COLLECTION,
+  ATSPI_DBUS_INTERFACE_COMPONENT,
+  ATSPI_DBUS_INTERFACE_DOCUMENT,
+  ATSPI_DBUS_INTERFACE_EDITABLE_TEXT,
+  ATSPI_DBUS_INTERFACE_HYPERLINK,
+  ATSPI_DBUS_INTERFACE_HYPERTEXT,
+  ATSPI_DBUS_INTERFACE_IMAGE,
+  ATSPI_DBUS_INTERFACE_SELECTION,
+  ATSPI_DBUS_INTERFACE_TABLE,
+  ATSPI_DBUS_INTERFACE_TABLE_CELL,
+  ATSPI_DBUS_INTERFACE_TEXT,
+  ATSPI_DBUS_INTERFACE_VALUE
+};
+
+static void
+append_compact_interfaces (DBusMessageIter * iter)
+{
+  DBusMessageIter iter_array;
+  guint i;
+
+  dbus_message_iter_open_container (iter, DBUS_TYPE_ARRAY, "s", &iter_array);
+  for (i = 0; i < G_N_ELEMENTS (compact_interfaces); i++)
+    dbus_message_iter_append_basic (&iter_array, DBUS_TYPE_STRING,
+                                    &compact_interfaces[i]);
+  dbus_message_iter_close_container (iter, &iter_array);
+}
+
+static dbus_uint32_t
+compact_interface_mask (const SpiCacheItem * item)
+{
+  dbus_uint32_t mask = 0;
+  guint i, j;
+
+  for (i = 0; i < item->n_interfaces; i++)
+    for (j = 0; j < G_N_ELEMENTS (compact_interfaces); j++)
+      if (!strcmp (item->interfaces[i], compact_interfaces[j]))
+        {
+          mask |= 1 << j;
+          break;
+        }
+  return mask;
+}
+
+/*
+ * Returns ref as sent, leasing its object as sending a full reference
+ * to it would.
+ */
+static dbus_uint64_t
+compact_ref (guint64 ref)
+{
+  AtkObject *obj = spi_cache_item_ref_to_object (ref);
+
+  if (!obj)
+    return COMPACT_NO_REF;
+  spi_object_lease_if_needed (G_OBJECT (obj));
+  return ref;
+}
+
+static void
+append_compact_item (AtkObject * obj, guint fields,
+                     DBusMessageIter * iter_array)
 {
   DBusMessageIter iter_struct, iter_sub_array;
-  dbus_uint32_t states[2];
-  int count;
-  AtkStateSet *set;
-  DBusMessageIter *iter_array = (DBusMessageIter *) data;
-
-  const char *name, *desc;
-  dbus_uint32_t role;
-
-  set = atk_object_ref_state_set (obj);
-  {
-    AtkObject *application, *parent;
-
-    dbus_message_iter_open_container (iter_array, DBUS_TYPE_STRUCT, NULL,
-                                      &iter_struct);
-
-    /* Marshall object path */
-    spi_object_append_reference (&iter_struct, obj);
-
-    role = spi_accessible_role_from_atk_role (atk_object_get_role (obj));
-
-    /* Marshall application */
-    application = spi_global_app_data->root; 
-    spi_object_append_reference (&iter_struct, application);
-
-    /* Marshall parent */
-    parent = atk_object_get_parent (obj);
-    if (parent == NULL)
-      {
-        /* TODO, move in to a 'Plug' wrapper. */
-        if (ATK_IS_PLUG (obj))
-          {
-            char *id = g_object_get_data (G_OBJECT (obj), "dbus-plug-parent");
-            char *bus_parent;
-            char *path_parent;
-
-            if (id)
-              {
-                bus_parent = g_strdup (id);
-                if (bus_parent && (path_parent = g_utf8_strchr (bus_parent + 1, -1, ':')))
-                  {
-                    DBusMessageIter iter_parent;
-                    *(path_parent++) = '\0';
-                    dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_STRUCT, NULL,
-                                                      &iter_parent);
-                    dbus_message_iter_append_basic (&iter_parent, DBUS_TYPE_STRING, &bus_parent);
-                    dbus_message_iter_append_basic (&iter_parent, DBUS_TYPE_OBJECT_PATH, &path_parent);
-                    dbus_message_iter_close_container (&iter_struct, &iter_parent);
-                  }
-                else
-                  {
-                    spi_object_append_null_reference (&iter_struct);
-                  }
-              }
-            else
-              {
-                spi_object_append_null_reference (&iter_struct);
-              }
-          }
-        else if (role != ATSPI_ROLE_APPLICATION)
-          spi_object_append_null_reference (&iter_struct);
-        else
-          spi_object_append_desktop_reference (&iter_struct);
-      }
-    else
-      {
-        spi_object_append_reference (&iter_struct, parent);
-      }
-
-    /* Marshall children */
-    dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "(so)",
-                                      &iter_sub_array);
-    if (!atk_state_set_contains_state (set, ATK_STATE_MANAGES_DESCENDANTS) &&
-        !atk_state_set_contains_state (set, ATK_STATE_DEFUNCT))
-      {
-        gint childcount, i;
-
-        childcount = atk_object_get_n_accessible_children (obj);
-        for (i = 0; i < childcount; i++)
-          {
-            AtkObject *child;
-
-            child = atk_object_ref_accessible_child (obj, i);
-            if (child)
-              {
-                spi_object_append_reference (&iter_sub_array, child);
-                g_object_unref (G_OBJECT (child));
-              }
-          }
-      }
-    if (ATK_IS_SOCKET (obj) && atk_socket_is_occupied (ATK_SOCKET (obj)))
-      {
-        AtkSocket *socket = ATK_SOCKET (obj);
-        gchar *child_name, *child_path;
-        child_name = g_strdup (socket->embedded_plug_id);
-        child_path = g_utf8_strchr (child_name + 1, -1, ':');
-        if (child_path)
-          {
-            DBusMessageIter iter_socket;
-            *(child_path++) = '\0';
-            dbus_message_iter_open_container (&iter_sub_array, DBUS_TYPE_STRUCT, NULL,
-                                              &iter_socket);
-            dbus_message_iter_append_basic (&iter_socket, DBUS_TYPE_STRING, &child_name);
-            dbus_message_iter_append_basic (&iter_socket, DBUS_TYPE_OBJECT_PATH, &child_path);
-            dbus_message_iter_close_container (&iter_sub_array, &iter_socket);
-          }
-        g_free (child_name);
-      }
-
-    dbus_message_iter_close_container (&iter_struct, &iter_sub_array);
-
-    /* Marshall interfaces */
-    dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "s",
-                                      &iter_sub_array);
-    spi_object_append_interfaces (&iter_sub_array, obj);
-    dbus_message_iter_close_container (&iter_struct, &iter_sub_array);
-
-    /* Marshall name */
-    name = atk_object_get_name (obj);
-    if (!name)
-      name = "";
-    dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &name);
-
-    /* Marshall role */
-    dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT32, &role);
-
-    /* Marshall description */
-    desc = atk_object_get_description (obj);
-    if (!desc)
-      desc = "";
-    dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &desc);
-
-    /* Marshall state set */
-    spi_atk_state_set_to_dbus_array (set, states);
-    dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "u",
-                                      &iter_sub_array);
-    for (count = 0; count < 2; count++)
-      {
-        dbus_message_iter_append_basic (&iter_sub_array, DBUS_TYPE_UINT32,
-                                        &states[count]);
-      }
-    dbus_message_iter_close_container (&iter_struct, &iter_sub_array);
-  }
+  const SpiCacheItem *item;
+  const char *name = "", *desc = "";
+  dbus_uint64_t ref, parent = COMPACT_NO_REF;
+  dbus_uint32_t interfaces = 0, role = 0;
+  dbus_uint32_t states[2] = { 0, 0 };
+  guint i;
+
+  item = spi_cache_get_item (spi_global_cache, obj);
+  ref = spi_register_object_to_ref (G_OBJECT (obj));
+
+  if ((fields & SPI_CACHE_FIELD_PARENT) && item->has_parent)
+    parent = compact_ref (item->parent);
+  if ((fields & SPI_CACHE_FIELD_NAME) && item->name)
+    name = item->name;
+  if ((fields & SPI_CACHE_FIELD_DESCRIPTION) && item->description)
+    desc = item->description;
+  if (fields & SPI_CACHE_FIELD_ROLE)
+    role = item->role;
+  if (fields & COMPACT_FIELD_INTERFACES)
+    interfaces = compact_interface_mask (item);
+  if (fields & SPI_CACHE_FIELD_STATES)
+    {
+      states[0] = item->states[0];
+      states[1] = item->states[1];
+    }
+
+  dbus_message_iter_open_container (iter_array, DBUS_TYPE_STRUCT, NULL,
+                                    &iter_struct);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64, &ref);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64, &parent);
+
+  dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "t",
+                                    &iter_sub_array);
+  if (fields & SPI_CACHE_FIELD_CHILDREN)
+    {
+      for (i = 0; i < item->children->len; i++)
+        {
+          dbus_uint64_t child;
+
+          child = compact_ref (g_array_index (item->children, guint64, i));
+          if (child != COMPACT_NO_REF)
+            dbus_message_iter_append_basic (&iter_sub_array, DBUS_TYPE_UINT64,
+                                            &child);
+        }
+    }
+  dbus_message_iter_close_container (&iter_struct, &iter_sub_array);
+
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT32, &interfaces);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &name);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT32, &role);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &desc);
+
+  dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "u",
+                                    &iter_sub_array);
+  for (i = 0; i < 2; i++)
+    dbus_message_iter_append_basic (&iter_sub_array, DBUS_TYPE_UINT32,
+                                    &states[i]);
+  dbus_message_iter_close_container (&iter_struct, &iter_sub_array);
   dbus_message_iter_close_container (iter_array, &iter_struct);
-  g_object_unref (set);
+}
+
+/*
+ * Whether any client opted in to compact cache signals by registering
+ * for "cache:compact". They are sent to those clients only, in addition
+ * to the full signals, which are broadcast as ever since other
+ * listeners rely on them.
+ */
+static gboolean
+any_compact_clients (void)
+{
+  guint n_clients;
+
+  return spi_atk_count_compact_clients (&n_clients) > 0;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -244,11 +504,254 @@ add_to_list_hf (gpointer key, gpointer obj_data, gpointer data)
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * Clients that opted in (see spi_atk_count_batching_clients) get the
+ * adds and removes of one main loop pass in a single AddAccessibles and
+ * a single RemoveAccessibles signal rather than one signal per object.
+ * The batched signals are sent to those clients only. The per-object
+ * signals are still broadcast unless every known client has opted in.
+ *
+ * Adds are kept as objects and marshalled when the batch is flushed, so
+ * an object added and removed within one pass is never mentioned.
+ * Removes are kept in an SpiRemovals. At flush time each removed subtree
+ * it finds is sent as one RemoveSubtree signal, telling clients to drop
+ * the object and everything below it, and the other removed objects go
+ * in RemoveAccessibles.
+ */
+
+/* Most items sent in one batched signal */
+#define CACHE_BATCH_MAX_ITEMS (4096)
+
+typedef struct _CacheBatch CacheBatch;
+struct _CacheBatch
+{
+  GQueue adds;
+  GHashTable *add_links;
+  SpiRemovals *removals;
+  guint flush_idle;
+};
+
+static CacheBatch batch = { G_QUEUE_INIT, NULL, NULL, 0 };
+
+static void
+send_remove_subtree (const gchar *path)
+{
+  DBusMessage *message;
+  DBusMessageIter iter, iter_struct;
+
+  message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
+                                     ATSPI_DBUS_INTERFACE_CACHE,
+                                     "RemoveSubtree");
+  if (!message)
+    return;
+
+  dbus_message_iter_init_append (message, &iter);
+  dbus_message_iter_open_container (&iter, DBUS_TYPE_STRUCT, NULL,
+                                    &iter_struct);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING,
+                                  &spi_global_app_data->bus_name);
+  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH, &path);
+  dbus_message_iter_close_container (&iter, &iter_struct);
+
+  spi_atk_send_to_clients (message, SPI_CLIENT_BATCHED, 0);
+  dbus_message_unref (message);
+}
+
+static void
+send_batched_removes (void)
+{
+  DBusMessage *message;
+  DBusMessageIter iter, iter_array, iter_struct;
+  GPtrArray *subtrees, *paths;
+  guint i;
+
+  subtrees = g_ptr_array_new ();
+  paths = g_ptr_array_new ();
+  spi_removals_sort (batch.removals, subtrees, paths);
+  for (i = 0; i < subtrees->len; i++)
+    send_remove_subtree (g_ptr_array_index (subtrees, i));
+
+  i = 0;
+  while (i < paths->len)
+    {
+      guint end = MIN (i + CACHE_BATCH_MAX_ITEMS, paths->len);
+
+      message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
+                                         ATSPI_DBUS_INTERFACE_CACHE,
+                                         "RemoveAccessibles");
+      if (!message)
+        break;
+
+      dbus_message_iter_init_append (message, &iter);
+      dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY,
+                                        SPI_OBJECT_REFERENCE_SIGNATURE,
+                                        &iter_array);
+      for (; i < end; i++)
+        {
+          const gchar *path = g_ptr_array_index (paths, i);
+
+          dbus_message_iter_open_container (&iter_array, DBUS_TYPE_STRUCT,
+                                            NULL, &iter_struct);
+          dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING,
+                                          &spi_global_app_data->bus_name);
+          dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH,
+                                          &path);
+          dbus_message_iter_close_container (&iter_array, &iter_struct);
+        }
+      dbus_message_iter_close_container (&iter, &iter_array);
+
+      spi_atk_send_to_clients (message, SPI_CLIENT_BATCHED, 0);
+      dbus_message_unref (message);
+    }
+  g_ptr_array_free (subtrees, TRUE);
+  g_ptr_array_free (paths, TRUE);
+}
+
+/*
+ * Sends the batched adds, compact to the batching clients that opted in
+ * to that and in full to the others.
+ */
+static void
+send_batched_adds (gboolean compact)
+{
+  DBusMessage *message;
+  DBusMessageIter iter, iter_array;
+  GList *l = batch.adds.head;
+
+  while (l)
+    {
+      guint n = 0;
+
+      message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
+                                         ATSPI_DBUS_INTERFACE_CACHE,
+                                         compact ? "AddAccessiblesCompact" :
+                                                   "AddAccessibles");
+      if (!message)
+        break;
+
+      dbus_message_iter_init_append (message, &iter);
+      dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY,
+                                        compact ?
+                                          SPI_CACHE_COMPACT_ITEM_SIGNATURE :
+                                          SPI_CACHE_ITEM_SIGNATURE,
+                                        &iter_array);
+      for (; l && n < CACHE_BATCH_MAX_ITEMS; l = l->next)
+        {
+          /* It may have left the cache without being deregistered */
+          if (!spi_cache_in (spi_global_cache, l->data))
+            continue;
+          if (compact)
+            append_compact_item (ATK_OBJECT (l->data), COMPACT_FIELDS_ALL,
+                                 &iter_array);
+          else
+            append_cache_item (ATK_OBJECT (l->data), &iter_array);
+          n++;
+        }
+      dbus_message_iter_close_container (&iter, &iter_array);
+
+      if (n > 0 && compact)
+        spi_atk_send_to_clients (message,
+                                 SPI_CLIENT_BATCHED | SPI_CLIENT_COMPACT, 0);
+      else if (n > 0)
+        spi_atk_send_to_clients (message, SPI_CLIENT_BATCHED,
+                                 SPI_CLIENT_COMPACT);
+      dbus_message_unref (message);
+    }
+}
+
+static gboolean
+flush_batch (gpointer data)
+{
+  batch.flush_idle = 0;
+
+  if (spi_global_app_data)
+    {
+      /* A remove and a later re-add of the same object must stay in order */
+      send_batched_removes ();
+      send_batched_adds (FALSE);
+      if (any_compact_clients ())
+        send_batched_adds (TRUE);
+    }
+
+  spi_removals_clear (batch.removals);
+  g_hash_table_remove_all (batch.add_links);
+  while (!g_queue_is_empty (&batch.adds))
+    g_object_unref (g_queue_pop_head (&batch.adds));
+  return FALSE;
+}
+
+static void
+batch_schedule_flush (void)
+{
+  if (!batch.add_links)
+    {
+      batch.add_links = g_hash_table_new (g_direct_hash, g_direct_equal);
+      batch.removals = spi_removals_new ();
+    }
+  if (batch.flush_idle == 0)
+    batch.flush_idle = g_idle_add (flush_batch, NULL);
+}
+
+static void
+batch_add (GObject * obj)
+{
+  batch_schedule_flush ();
+  if (g_hash_table_lookup (batch.add_links, obj))
+    return;
+
+  g_queue_push_tail (&batch.adds, g_object_ref (obj));
+  g_hash_table_insert (batch.add_links, obj, batch.adds.tail);
+}
+
+static void
+batch_remove (GObject * obj)
+{
+  GList *link;
+
+  batch_schedule_flush ();
+  link = g_hash_table_lookup (batch.add_links, obj);
+  if (link)
+    {
+      g_hash_table_remove (batch.add_links, obj);
+      g_queue_delete_link (&batch.adds, link);
+      g_object_unref (obj);
+      return;
+    }
+
+  spi_removals_add (batch.removals, spi_register_object_to_ref (obj),
+                    spi_register_object_to_path (spi_global_register, obj),
+                    spi_cache_peek_item (spi_global_cache, obj));
+}
+
+/*
+ * Queues obj for the batched signal if any client wants it, and returns
+ * whether the per-object signal is needed as well.
+ */
+static gboolean
+batch_change (GObject * obj, gboolean added)
+{
+  guint n_clients, n_batching;
+
+  n_batching = spi_atk_count_batching_clients (&n_clients);
+  if (n_batching == 0)
+    return TRUE;
+
+  if (added)
+    batch_add (obj);
+  else
+    batch_remove (obj);
+  return n_batching < n_clients;
+}
+
 static void
 emit_cache_remove (SpiCache *cache, GObject * obj)
 {
   DBusMessage *message;
 
+  /* Clients read the tree once it is complete; see emit_cache_add */
+  if (cache->populating || !batch_change (obj, FALSE))
+    return;
+
   if ((message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
                                           ATSPI_DBUS_INTERFACE_CACHE,
                                           "RemoveAccessible")))
@@ -265,27 +768,53 @@ emit_cache_remove (SpiCache *cache, GObject * obj)
     }
 }
 
+static DBusMessage *
+new_cache_add (AtkObject * accessible, gboolean compact)
+{
+  DBusMessage *message;
+  DBusMessageIter iter;
+
+  message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
+                                     ATSPI_DBUS_INTERFACE_CACHE,
+                                     compact ? "AddAccessibleCompact" :
+                                               "AddAccessible");
+  if (!message)
+    return NULL;
+
+  dbus_message_iter_init_append (message, &iter);
+  if (compact)
+    append_compact_item (accessible, COMPACT_FIELDS_ALL, &iter);
+  else
+    append_cache_item (accessible, &iter);
+  return message;
+}
+
 static void
 emit_cache_add (SpiCache *cache, GObject * obj)
 {
   AtkObject *accessible = ATK_OBJECT (obj);
   DBusMessage *message;
 
-  if ((message = dbus_message_new_signal (SPI_CACHE_OBJECT_PATH,
-                                          ATSPI_DBUS_INTERFACE_CACHE,
-                                          "AddAccessible")))
-    {
-      DBusMessageIter iter;
-
-      dbus_message_iter_init_append (message, &iter);
-      g_object_ref (accessible);
-      append_cache_item (accessible, &iter);
-      g_object_unref (accessible);
+  /*
+   * The initial walk runs over several idles. Clients get its objects
+   * from GetItems, which completes it, rather than one signal each.
+   */
+  if (cache->populating || !batch_change (obj, TRUE))
+    return;
 
+  g_object_ref (accessible);
+  if ((message = new_cache_add (accessible, FALSE)))
+    {
       dbus_connection_send (spi_global_app_data->bus, message, NULL);
-
       dbus_message_unref (message);
     }
+  if (any_compact_clients () &&
+      (message = new_cache_add (accessible, TRUE)))
+    {
+      spi_atk_send_to_clients (message, SPI_CLIENT_COMPACT, 0);
+      dbus_message_unref (message);
+    }
+  g_object_unref (accessible);
 }
 
 
@@ -299,26 +828,494 @@ impl_GetRoot (DBusConnection * bus, DBusMessage * message, void *user_data)
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * GetItems is answered incrementally: items are appended to the reply
+ * until the slice deadline passes, and the rest are appended from idle
+ * callbacks so that a huge cache does not stall the application.
+ *
+ * Large caches are written with a DRouteWire rather than through
+ * DBusMessageIter. Items already written are kept in done_items so
+ * that, should libdbus reject the result, the reply can be rebuilt.
+ */
+
+/* Caches smaller than this are not worth a DRouteWire */
+#define GET_ITEMS_WIRE_THRESHOLD (64)
+
+/* Rough size of one marshalled item, to size the wire buffer */
+#define GET_ITEMS_WIRE_ITEM_SIZE (256)
+
+typedef struct _GetItemsData GetItemsData;
+struct _GetItemsData
+{
+  DBusMessage *message;
+  DBusMessage *reply;
+  DBusMessageIter iter;
+  DBusMessageIter iter_array;
+  DRouteWire *wire;
+  gsize wire_array;
+  GSList *pending_items;
+  GSList *done_items;
+  guint compact_fields;
+};
+
+static void
+get_items_data_free (gpointer data)
+{
+  GetItemsData *gid = data;
+
+  g_slist_free_full (gid->pending_items, g_object_unref);
+  g_slist_free_full (gid->done_items, g_object_unref);
+  if (gid->wire)
+    droute_wire_free (gid->wire);
+  if (gid->reply)
+    dbus_message_unref (gid->reply);
+  dbus_message_unref (gid->message);
+  g_free (gid);
+}
+
+static void
+get_items_open_iter (GetItemsData *gid)
+{
+  gid->reply = dbus_message_new_method_return (gid->message);
+  dbus_message_iter_init_append (gid->reply, &gid->iter);
+  if (gid->compact_fields)
+    append_compact_interfaces (&gid->iter);
+  dbus_message_iter_open_container (&gid->iter, DBUS_TYPE_ARRAY,
+                                    gid->compact_fields ?
+                                      SPI_CACHE_COMPACT_ITEM_SIGNATURE :
+                                      SPI_CACHE_ITEM_SIGNATURE,
+                                    &gid->iter_array);
+}
+
+/*
+ * Turns the wire into the reply, or if that fails appends the items
+ * written so far through the iterators instead.
+ */
+static void
+get_items_finish_wire (GetItemsData *gid)
+{
+  GSList *l;
+
+  droute_wire_close_array (gid->wire, gid->wire_array);
+  gid->reply = droute_wire_finish (gid->wire);
+  gid->wire = NULL;
+  if (gid->reply)
+    return;
+
+  g_warning ("atk-bridge: could not build GetItems reply directly");
+  get_items_open_iter (gid);
+  gid->done_items = g_slist_reverse (gid->done_items);
+  for (l = gid->done_items; l; l = l->next)
+    append_accessible_hf (l->data, NULL, &gid->iter_array);
+  dbus_message_iter_close_container (&gid->iter, &gid->iter_array);
+}
+
+/*
+ * Appends items until the deadline, returning TRUE once all items
+ * have been appended and the array is closed.
+ */
+static gboolean
+get_items_append (GetItemsData *gid, gint64 deadline)
+{
+  while (gid->pending_items)
+    {
+      GSList *head = gid->pending_items;
+
+      gid->pending_items = g_slist_remove_link (gid->pending_items, head);
+
+      /* Skip items that left the cache since GetItems was called */
+      if (!spi_cache_in (spi_global_cache, head->data) ||
+          !ATK_IS_OBJECT (head->data))
+        {
+          g_object_unref (head->data);
+          g_slist_free_1 (head);
+        }
+      else if (gid->wire)
+        {
+          wire_append_cache_item (ATK_OBJECT (head->data), gid->wire);
+          gid->done_items = g_slist_concat (head, gid->done_items);
+        }
+      else
+        {
+          if (gid->compact_fields)
+            append_compact_item (ATK_OBJECT (head->data), gid->compact_fields,
+                                 &gid->iter_array);
+          else
+            append_cache_item (ATK_OBJECT (head->data), &gid->iter_array);
+          g_object_unref (head->data);
+          g_slist_free_1 (head);
+        }
+
+      if (gid->pending_items && g_get_monotonic_time () >= deadline)
+        return FALSE;
+    }
+
+  if (gid->wire)
+    get_items_finish_wire (gid);
+  else
+    dbus_message_iter_close_container (&gid->iter, &gid->iter_array);
+  return TRUE;
+}
+
+static gboolean
+get_items_slice (DRoutePendingReply *pending, gint64 deadline, void *data)
+{
+  GetItemsData *gid = data;
+
+  if (!get_items_append (gid, deadline))
+    return FALSE;
+
+  droute_pending_reply_complete (pending, gid->reply);
+  gid->reply = NULL;
+  return TRUE;
+}
+
+/*
+ * Replies to message with the given items, which the reply takes over
+ * along with the ref held on each of them. Unless compact_fields is 0
+ * the reply is the interface table followed by compact items.
+ */
+static DBusMessage *
+get_items_reply (DBusConnection * bus, DBusMessage * message, GSList *items,
+                 guint compact_fields)
+{
+  GetItemsData *gid;
+  DBusMessage *reply;
+  guint n_items;
+
+  gid = g_new0 (GetItemsData, 1);
+  gid->message = dbus_message_ref (message);
+  gid->pending_items = items;
+  gid->compact_fields = compact_fields;
+
+  /* Compact items are small enough for the iterators */
+  n_items = g_slist_length (gid->pending_items);
+  if (n_items >= GET_ITEMS_WIRE_THRESHOLD && !compact_fields)
+    {
+      gid->wire = droute_wire_new_reply (message,
+                                         DBUS_TYPE_ARRAY_AS_STRING
+                                         SPI_CACHE_ITEM_SIGNATURE,
+                                         n_items * GET_ITEMS_WIRE_ITEM_SIZE);
+      gid->wire_array = droute_wire_open_array (gid->wire, 8);
+    }
+  else
+    get_items_open_iter (gid);
+
+  if (!get_items_append (gid, g_get_monotonic_time () + DROUTE_SLICE_BUDGET_US))
+    {
+      droute_pending_reply_new (bus, message, get_items_slice, gid,
+                                get_items_data_free);
+      return NULL;
+    }
+
+  reply = gid->reply;
+  gid->reply = NULL;
+  get_items_data_free (gid);
+  return reply;
+}
+
 static DBusMessage *
 impl_GetItems (DBusConnection * bus, DBusMessage * message, void *user_data)
 {
+  GSList *items = NULL;
+
+  if (bus == spi_global_app_data->bus)
+    spi_atk_add_client (dbus_message_get_sender (message));
+
+  /* The initial walk of the tree may still be going on */
+  spi_cache_complete (spi_global_cache);
+
+  /* Hold a ref on every item, as some may go away between slices */
+  spi_cache_foreach (spi_global_cache, ref_accessible_hf, NULL);
+  spi_cache_foreach (spi_global_cache, add_to_list_hf, &items);
+
+  return get_items_reply (bus, message, items, 0);
+}
+
+/*
+ * GetItemsCompact is GetItems with compact items holding only the
+ * fields asked for. A fields of 0 asks for all of them.
+ */
+static DBusMessage *
+impl_GetItemsCompact (DBusConnection * bus, DBusMessage * message,
+                      void *user_data)
+{
+  SpiCacheGetItemsCompactArgs args;
+  GSList *items = NULL;
+
+  spi_cache_get_items_compact_decode (message, &args);
+  args.fields &= COMPACT_FIELDS_ALL;
+  if (args.fields == 0)
+    args.fields = COMPACT_FIELDS_ALL;
+
+  if (bus == spi_global_app_data->bus)
+    spi_atk_add_client (dbus_message_get_sender (message));
+
+  spi_cache_complete (spi_global_cache);
+
+  spi_cache_foreach (spi_global_cache, ref_accessible_hf, NULL);
+  spi_cache_foreach (spi_global_cache, add_to_list_hf, &items);
+
+  return get_items_reply (bus, message, items, args.fields);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * GetItemsForSubtree returns the cached objects below root, root
+ * included, down to max_depth levels below it, 0 meaning no limit.
+ * It follows the child links of the cache snapshots, so its cost
+ * depends on the size of the subtree rather than of the cache.
+ */
+static DBusMessage *
+impl_GetItemsForSubtree (DBusConnection * bus, DBusMessage * message,
+                         void *user_data)
+{
+  SpiCacheGetItemsForSubtreeArgs args;
+  GObject *root;
+  GHashTable *seen;
+  GQueue queue = G_QUEUE_INIT;
+  GSList *items = NULL;
+  guint depth, level_left;
+
+  spi_cache_get_items_for_subtree_decode (message, &args);
+
+  if (bus == spi_global_app_data->bus)
+    spi_atk_add_client (dbus_message_get_sender (message));
+
+  root = spi_register_path_to_object (spi_global_register, args.root_path);
+  if (!root || !ATK_IS_OBJECT (root))
+    return droute_invalid_arguments_error (message);
+
+  spi_cache_complete (spi_global_cache);
+
+  seen = g_hash_table_new (g_direct_hash, g_direct_equal);
+  if (spi_cache_in (spi_global_cache, root))
+    {
+      g_queue_push_tail (&queue, root);
+      g_hash_table_add (seen, root);
+    }
+
+  /* Breadth first, counting down the objects left on each level */
+  depth = 0;
+  level_left = queue.length;
+  while (!g_queue_is_empty (&queue))
+    {
+      AtkObject *obj = g_queue_pop_head (&queue);
+      const SpiCacheItem *item;
+      guint i;
+
+      items = g_slist_prepend (items, g_object_ref (obj));
+
+      item = spi_cache_get_item (spi_global_cache, obj);
+      if (args.max_depth == 0 || depth < args.max_depth)
+        {
+          for (i = 0; i < item->children->len; i++)
+            {
+              AtkObject *child;
+
+              child = spi_cache_item_ref_to_object (g_array_index (item->children,
+                                                                   guint64, i));
+              if (child && spi_cache_in (spi_global_cache, G_OBJECT (child)) &&
+                  !g_hash_table_contains (seen, child))
+                {
+                  g_hash_table_add (seen, child);
+                  g_queue_push_tail (&queue, child);
+                }
+            }
+        }
+
+      if (--level_left == 0)
+        {
+          depth++;
+          level_left = queue.length;
+        }
+    }
+  g_hash_table_destroy (seen);
+
+  return get_items_reply (bus, message, g_slist_reverse (items), 0);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * GetItemsPage returns the cache a page at a time, so that neither the
+ * bridge nor the client has to hold the whole tree in one message.
+ *
+ * Items are returned in register slot order, after the root on the
+ * first page. The cursor is the slot to carry on from: 0 starts a walk,
+ * and a returned cursor of 0 means the walk is complete. Objects added
+ * behind the cursor during a walk are not returned, so a client should
+ * note the generation from the first page and finish with a call to
+ * GetItemsSince.
+ */
+
+/* Pages are never larger than this, whatever the client asks for */
+#define GET_ITEMS_PAGE_MAX (4096)
+
+static DBusMessage *
+impl_GetItemsPage (DBusConnection * bus, DBusMessage * message,
+                   void *user_data)
+{
+  SpiCacheGetItemsPageArgs args;
   DBusMessage *reply;
   DBusMessageIter iter, iter_array;
-  GSList *pending_unrefs = NULL;
+  SpiObjectRecord *record;
+  dbus_uint32_t cursor, generation;
+  guint n = 0;
+
+  spi_cache_get_items_page_decode (message, &args);
 
   if (bus == spi_global_app_data->bus)
     spi_atk_add_client (dbus_message_get_sender (message));
 
+  spi_cache_complete (spi_global_cache);
+  args.max_items = CLAMP (args.max_items, 1, GET_ITEMS_PAGE_MAX);
+
   reply = dbus_message_new_method_return (message);
+  if (!reply)
+    return NULL;
 
   dbus_message_iter_init_append (reply, &iter);
   dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY,
                                     SPI_CACHE_ITEM_SIGNATURE, &iter_array);
-  spi_cache_foreach (spi_global_cache, ref_accessible_hf, NULL);
-  spi_cache_foreach (spi_global_cache, append_accessible_hf, &iter_array);
-  spi_cache_foreach (spi_global_cache, add_to_list_hf, &pending_unrefs);
-  g_slist_free_full (pending_unrefs, g_object_unref);
+
+  cursor = args.cursor;
+  if (cursor == 0)
+    {
+      append_cache_item (spi_global_app_data->root, &iter_array);
+      n++;
+      cursor = 1;
+    }
+
+  while (n < args.max_items &&
+         (record = spi_register_next_record (spi_global_register, &cursor)))
+    {
+      if (record->in_cache && ATK_IS_OBJECT (record->gobj))
+        {
+          append_cache_item (ATK_OBJECT (record->gobj), &iter_array);
+          n++;
+        }
+    }
+
   dbus_message_iter_close_container (&iter, &iter_array);
+
+  generation = spi_global_cache->generation;
+  dbus_message_iter_append_basic (&iter, DBUS_TYPE_UINT32, &cursor);
+  dbus_message_iter_append_basic (&iter, DBUS_TYPE_UINT32, &generation);
+  return reply;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * GetItemsSince lets a client that was in sync at some generation catch
+ * up with just the items added or changed, and the references removed,
+ * since. Several changes to one object are collapsed to the latest. If
+ * the cache no longer remembers that far back the reply says so and the
+ * client should fall back to GetItems. Either way the reply carries the
+ * current generation to ask from next time.
+ */
+
+typedef struct _GetItemsSinceData GetItemsSinceData;
+struct _GetItemsSinceData
+{
+  GHashTable *kinds;
+  GArray *refs;
+};
+
+/* Returns the object with ref if it is still in the cache */
+static GObject *
+cached_ref_to_object (guint64 ref)
+{
+  GObject *gobj;
+
+  if (ref == 0)
+    return G_OBJECT (spi_global_app_data->root);
+
+  gobj = spi_register_ref_to_object (spi_global_register, ref);
+  if (gobj && spi_cache_in (spi_global_cache, gobj))
+    return gobj;
+  return NULL;
+}
+
+static DBusMessage *
+impl_GetItemsSince (DBusConnection * bus, DBusMessage * message,
+                    void *user_data)
+{
+  SpiCacheGetItemsSinceArgs args;
+  GetItemsSinceData gisd;
+  DBusMessage *reply;
+  DBusMessageIter iter, iter_array, iter_struct;
+  dbus_uint32_t current;
+  dbus_bool_t too_old;
+  guint i;
+
+  spi_cache_get_items_since_decode (message, &args);
+
+  if (bus == spi_global_app_data->bus)
+    spi_atk_add_client (dbus_message_get_sender (message));
+
+  gisd.kinds = g_hash_table_new (g_int64_hash, g_int64_equal);
+  gisd.refs = g_array_new (FALSE, FALSE, sizeof (guint64));
+  current = spi_global_cache->generation;
+  too_old = !spi_cache_collect_changes_since (spi_global_cache,
+                                              args.generation,
+                                              gisd.refs, gisd.kinds);
+
+  reply = dbus_message_new_method_return (message);
+  if (!reply)
+    goto out;
+
+  dbus_message_iter_init_append (reply, &iter);
+  dbus_message_iter_append_basic (&iter, DBUS_TYPE_UINT32, &current);
+  dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &too_old);
+
+  dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY,
+                                    SPI_CACHE_ITEM_SIGNATURE, &iter_array);
+  for (i = 0; i < gisd.refs->len; i++)
+    {
+      guint64 *ref = &g_array_index (gisd.refs, guint64, i);
+      GObject *gobj;
+
+      if (GPOINTER_TO_UINT (g_hash_table_lookup (gisd.kinds, ref)) ==
+          SPI_CACHE_CHANGE_REMOVE)
+        continue;
+      gobj = cached_ref_to_object (*ref);
+      if (gobj)
+        append_cache_item (ATK_OBJECT (gobj), &iter_array);
+      else
+        g_hash_table_insert (gisd.kinds, ref,
+                             GUINT_TO_POINTER (SPI_CACHE_CHANGE_REMOVE));
+    }
+  dbus_message_iter_close_container (&iter, &iter_array);
+
+  dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY,
+                                    SPI_OBJECT_REFERENCE_SIGNATURE,
+                                    &iter_array);
+  for (i = 0; i < gisd.refs->len; i++)
+    {
+      guint64 *ref = &g_array_index (gisd.refs, guint64, i);
+      gchar *path;
+
+      if (GPOINTER_TO_UINT (g_hash_table_lookup (gisd.kinds, ref)) !=
+          SPI_CACHE_CHANGE_REMOVE)
+        continue;
+      path = spi_register_ref_to_path (*ref);
+      dbus_message_iter_open_container (&iter_array, DBUS_TYPE_STRUCT, NULL,
+                                        &iter_struct);
+      dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING,
+                                      &spi_global_app_data->bus_name);
+      dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH,
+                                      &path);
+      dbus_message_iter_close_container (&iter_array, &iter_struct);
+      g_free (path);
+    }
+  dbus_message_iter_close_container (&iter, &iter_array);
+
+out:
+  g_hash_table_destroy (gisd.kinds);
+  g_array_free (gisd.refs, TRUE);
   return reply;
 }
 
@@ -326,14 +1323,20 @@ impl_GetItems (DBusConnection * bus, DBusMessage * message, void *user_data)
 
 static DRouteMethod methods[] = {
   {impl_GetRoot, "GetRoot"},
-  {impl_GetItems, "GetItems"},
+  {impl_GetItems, "GetItems", SPI_CACHE_GET_ITEMS_SIGNATURE},
+  {impl_GetItemsCompact, "GetItemsCompact",
+   SPI_CACHE_GET_ITEMS_COMPACT_SIGNATURE},
+  {impl_GetItemsPage, "GetItemsPage", SPI_CACHE_GET_ITEMS_PAGE_SIGNATURE},
+  {impl_GetItemsForSubtree, "GetItemsForSubtree",
+   SPI_CACHE_GET_ITEMS_FOR_SUBTREE_SIGNATURE},
+  {impl_GetItemsSince, "GetItemsSince", SPI_CACHE_GET_ITEMS_SINCE_SIGNATURE},
   {NULL, NULL}
 };
 
 void
 spi_initialize_cache (DRoutePath * path)
 {
-  droute_path_add_interface (path, ATSPI_DBUS_INTERFACE_CACHE, spi_org_a11y_atspi_Cache, methods, NULL);
+  droute_path_add_interface (path, ATSPI_DBUS_INTERFACE_CACHE, spi_bridge_org_a11y_atspi_Cache, methods, NULL);
 
   g_signal_connect (spi_global_cache, "object-added",
                     (GCallback) emit_cache_add, NULL);
@@ -34,7 +34,8 @@
 
 #include "accessible-register.h"
 #include "object.h"
-#include "introspection.h"
+#include "introspection-bridge.h"
+#include "method-args.h"
 
 typedef struct _MatchRulePrivate MatchRulePrivate;
 struct _MatchRulePrivate
@@ -958,13 +959,6 @@ impl_GetMatchesFrom (DBusConnection * bus, DBusMessage * message,
   dbus_uint32_t tree;
   dbus_int32_t count;
   dbus_bool_t traverse;
-  const char *signature;
-
-  signature = dbus_message_get_signature (message);
-  if (strcmp (signature, "o(aiia{ss}iaiiasib)uuib") != 0)
-    {
-      return droute_invalid_arguments_error (message);
-    }
 
   dbus_message_iter_init (message, &iter);
   dbus_message_iter_get_basic (&iter, &current_object_path);
@@ -1020,13 +1014,6 @@ impl_GetMatchesTo (DBusConnection * bus, DBusMessage * message,
   dbus_bool_t recurse;
   dbus_int32_t count;
   dbus_bool_t traverse;
-  const char *signature;
-
-  signature = dbus_message_get_signature (message);
-  if (strcmp (signature, "o(aiia{ss}iaiiasib)uubib") != 0)
-    {
-      return droute_invalid_arguments_error (message);
-    }
 
   dbus_message_iter_init (message, &iter);
   dbus_message_iter_get_basic (&iter, &current_object_path);
@@ -1299,13 +1286,6 @@ impl_GetMatches (DBusConnection * bus, DBusMessage * message, void *user_data)
   dbus_int32_t count;
   dbus_bool_t traverse;
   GList *ls = NULL;
-  const char *signature;
-
-  signature = dbus_message_get_signature (message);
-  if (strcmp (signature, "(aiia{ss}iaiiasib)uib") != 0)
-    {
-      return droute_invalid_arguments_error (message);
-    }
 
   dbus_message_iter_init (message, &iter);
   if (!read_mr (&iter, &rule))
@@ -1330,10 +1310,10 @@ impl_GetMatches (DBusConnection * bus, DBusMessage * message, void *user_data)
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetMatchesFrom, "GetMatchesFrom"},
-  {impl_GetMatchesTo, "GetMatchesTo"},
+  {impl_GetMatchesFrom, "GetMatchesFrom", SPI_COLLECTION_GET_MATCHES_FROM_SIGNATURE},
+  {impl_GetMatchesTo, "GetMatchesTo", SPI_COLLECTION_GET_MATCHES_TO_SIGNATURE},
   {impl_GetTree, "GetTree"},
-  {impl_GetMatches, "GetMatches"},
+  {impl_GetMatches, "GetMatches", SPI_COLLECTION_GET_MATCHES_SIGNATURE},
   {NULL, NULL}
 };
 
@@ -1341,5 +1321,5 @@ void
 spi_initialize_collection (DRoutePath * path)
 {
   spi_atk_add_interface (path,
-                         ATSPI_DBUS_INTERFACE_COLLECTION, spi_org_a11y_atspi_Collection, methods, NULL);
+                         ATSPI_DBUS_INTERFACE_COLLECTION, spi_bridge_org_a11y_atspi_Collection, methods, NULL);
 };
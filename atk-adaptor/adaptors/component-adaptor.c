@@ -29,7 +29,8 @@
 
 #include "spi-dbus.h"
 #include "object.h"
-#include "introspection.h"
+#include "introspection-bridge.h"
+#include "method-args.h"
 
 static DBusMessage *
 impl_Contains (DBusConnection * bus, DBusMessage * message, void *user_data)
@@ -299,11 +300,6 @@ impl_SetExtents (DBusConnection * bus, DBusMessage * message, void *user_data)
   g_return_val_if_fail (ATK_IS_COMPONENT (user_data),
                         droute_not_yet_handled_error (message));
 
-  if (strcmp (dbus_message_get_signature (message), "(iiii)u") != 0)
-    {
-      return droute_invalid_arguments_error (message);
-    }
-
   dbus_message_iter_init (message, &iter);
   dbus_message_iter_recurse (&iter, &iter_struct);
   dbus_message_iter_get_basic (&iter_struct, &x);
@@ -419,20 +415,20 @@ impl_SetSize (DBusConnection * bus, DBusMessage * message, void *user_data)
 }
 
 static DRouteMethod methods[] = {
-  {impl_Contains, "Contains"},
-  {impl_GetAccessibleAtPoint, "GetAccessibleAtPoint"},
-  {impl_GetExtents, "GetExtents"},
-  {impl_GetPosition, "GetPosition"},
-  {impl_GetSize, "GetSize"},
-  {impl_GetLayer, "GetLayer"},
-  {impl_GetMDIZOrder, "GetMDIZOrder"},
-  {impl_GrabFocus, "GrabFocus"},
+  {impl_Contains, "Contains", SPI_COMPONENT_CONTAINS_SIGNATURE},
+  {impl_GetAccessibleAtPoint, "GetAccessibleAtPoint", SPI_COMPONENT_GET_ACCESSIBLE_AT_POINT_SIGNATURE},
+  {impl_GetExtents, "GetExtents", SPI_COMPONENT_GET_EXTENTS_SIGNATURE},
+  {impl_GetPosition, "GetPosition", SPI_COMPONENT_GET_POSITION_SIGNATURE},
+  {impl_GetSize, "GetSize", SPI_COMPONENT_GET_SIZE_SIGNATURE},
+  {impl_GetLayer, "GetLayer", SPI_COMPONENT_GET_LAYER_SIGNATURE},
+  {impl_GetMDIZOrder, "GetMDIZOrder", SPI_COMPONENT_GET_MDIZ_ORDER_SIGNATURE},
+  {impl_GrabFocus, "GrabFocus", SPI_COMPONENT_GRAB_FOCUS_SIGNATURE},
   //{impl_registerFocusHandler, "registerFocusHandler"},
   //{impl_deregisterFocusHandler, "deregisterFocusHandler"},
-  {impl_GetAlpha, "GetAlpha"},
-  {impl_SetExtents, "SetExtents"},
-  {impl_SetPosition, "SetPosition"},
-  {impl_SetSize, "SetSize"},
+  {impl_GetAlpha, "GetAlpha", SPI_COMPONENT_GET_ALPHA_SIGNATURE},
+  {impl_SetExtents, "SetExtents", SPI_COMPONENT_SET_EXTENTS_SIGNATURE},
+  {impl_SetPosition, "SetPosition", SPI_COMPONENT_SET_POSITION_SIGNATURE},
+  {impl_SetSize, "SetSize", SPI_COMPONENT_SET_SIZE_SIGNATURE},
   {NULL, NULL}
 };
 
@@ -444,5 +440,5 @@ void
 spi_initialize_component (DRoutePath * path)
 {
   spi_atk_add_interface (path,
-                         ATSPI_DBUS_INTERFACE_COMPONENT, spi_org_a11y_atspi_Component, methods, properties);
+                         ATSPI_DBUS_INTERFACE_COMPONENT, spi_bridge_org_a11y_atspi_Component, methods, properties);
 };
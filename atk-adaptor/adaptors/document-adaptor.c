@@ -29,6 +29,7 @@
 #include "spi-dbus.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_CurrentPageNumber (DBusMessageIter * iter, void *user_data)
@@ -122,9 +123,9 @@ impl_GetAttributes (DBusConnection * bus, DBusMessage * message,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetLocale, "GetLocale"},
-  {impl_GetAttributeValue, "GetAttributeValue"},
-  {impl_GetAttributes, "GetAttributes"},
+  {impl_GetLocale, "GetLocale", SPI_DOCUMENT_GET_LOCALE_SIGNATURE},
+  {impl_GetAttributeValue, "GetAttributeValue", SPI_DOCUMENT_GET_ATTRIBUTE_VALUE_SIGNATURE},
+  {impl_GetAttributes, "GetAttributes", SPI_DOCUMENT_GET_ATTRIBUTES_SIGNATURE},
   {NULL, NULL}
 };
 
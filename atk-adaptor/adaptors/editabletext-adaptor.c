@@ -28,6 +28,7 @@
 #include "introspection.h"
 
 #include "spi-dbus.h"
+#include "method-args.h"
 
 static DBusMessage *
 impl_SetTextContents (DBusConnection * bus, DBusMessage * message,
@@ -190,12 +191,12 @@ impl_PasteText (DBusConnection * bus, DBusMessage * message, void *user_data)
 }
 
 static DRouteMethod methods[] = {
-  {impl_SetTextContents, "SetTextContents"},
-  {impl_InsertText, "InsertText"},
-  {impl_CopyText, "CopyText"},
-  {impl_CutText, "CutText"},
-  {impl_DeleteText, "DeleteText"},
-  {impl_PasteText, "PasteText"},
+  {impl_SetTextContents, "SetTextContents", SPI_EDITABLE_TEXT_SET_TEXT_CONTENTS_SIGNATURE},
+  {impl_InsertText, "InsertText", SPI_EDITABLE_TEXT_INSERT_TEXT_SIGNATURE},
+  {impl_CopyText, "CopyText", SPI_EDITABLE_TEXT_COPY_TEXT_SIGNATURE},
+  {impl_CutText, "CutText", SPI_EDITABLE_TEXT_CUT_TEXT_SIGNATURE},
+  {impl_DeleteText, "DeleteText", SPI_EDITABLE_TEXT_DELETE_TEXT_SIGNATURE},
+  {impl_PasteText, "PasteText", SPI_EDITABLE_TEXT_PASTE_TEXT_SIGNATURE},
   {NULL, NULL}
 };
 
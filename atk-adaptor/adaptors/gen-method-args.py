@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+#
+# Generates method-args.h and method-args.c from the interface XML
+# embedded in atk-adaptor/introspection.c and introspection-bridge.c.
+# An interface defined in a later file replaces the one of that name
+# in an earlier one.
+#
+# For every method of the interfaces the bridge implements this emits the
+# D-Bus signature of its input arguments, which droute checks before the
+# handler is called. For methods whose arguments are all basic types or
+# (so) object references it also emits a struct holding them and a
+# decoder filling it in, and for methods whose results are all basic
+# types a function building the reply.
+#
+# Usage: gen-method-args.py introspection.c... method-args.h method-args.c
+
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+# Interfaces the bridge talks to rather than implements
+SKIPPED = (
+    "org.a11y.atspi.Registry",
+    "org.a11y.atspi.DeviceEventController",
+    "org.a11y.atspi.DeviceEventListener",
+)
+
+BASIC_TYPES = {
+    "y": ("unsigned char", "DBUS_TYPE_BYTE"),
+    "b": ("dbus_bool_t", "DBUS_TYPE_BOOLEAN"),
+    "n": ("dbus_int16_t", "DBUS_TYPE_INT16"),
+    "q": ("dbus_uint16_t", "DBUS_TYPE_UINT16"),
+    "i": ("dbus_int32_t", "DBUS_TYPE_INT32"),
+    "u": ("dbus_uint32_t", "DBUS_TYPE_UINT32"),
+    "x": ("dbus_int64_t", "DBUS_TYPE_INT64"),
+    "t": ("dbus_uint64_t", "DBUS_TYPE_UINT64"),
+    "d": ("double", "DBUS_TYPE_DOUBLE"),
+    "s": ("const char *", "DBUS_TYPE_STRING"),
+    "o": ("const char *", "DBUS_TYPE_OBJECT_PATH"),
+}
+
+# An object reference, decoded into <name>_bus_name and <name>_path
+REFERENCE = "(so)"
+REFERENCE_FIELDS = (("s", "bus_name"), ("o", "path"))
+
+HEADER = """/*
+ * This file has been generated by gen-method-args.py from the
+ * introspection data in introspection.c and introspection-bridge.c.
+ *
+ * DO NOT EDIT.
+ */
+"""
+
+
+def snake (name):
+    name = re.sub (r"([a-z0-9])([A-Z])", r"\1_\2", name)
+    return re.sub (r"([A-Z]+)([A-Z][a-z])", r"\1_\2", name).lower ()
+
+
+def read_interfaces (filename):
+    source = open (filename).read ()
+    interfaces = []
+    for match in re.finditer (r'const char \*\w+ =\s*((?:"(?:[^"\\]|\\.)*"\s*)+);',
+                              source):
+        literals = re.findall (r'"((?:[^"\\]|\\.)*)"', match.group (1))
+        xml = "".join (literals).replace ('\\"', '"').replace ("\\\\", "\\")
+        interfaces.append (ET.fromstring (xml))
+    return interfaces
+
+
+class Method:
+    def __init__ (self, iface, element):
+        short = iface.get ("name").split (".")[-1]
+        self.name = element.get ("name")
+        self.prefix = "spi_%s_%s" % (snake (short), snake (self.name))
+        self.struct = "Spi%s%sArgs" % (short, self.name)
+        self.ins = []
+        self.outs = []
+        for arg in element.findall ("arg"):
+            if arg.get ("direction", "in") == "in":
+                self.ins.append (arg)
+            else:
+                self.outs.append (arg)
+        self.signature = "".join (arg.get ("type") for arg in self.ins)
+
+    def decodable (self):
+        return self.ins and all (a.get ("type") in BASIC_TYPES or
+                                 a.get ("type") == REFERENCE for a in self.ins)
+
+    def encodable (self):
+        return all (a.get ("type") in BASIC_TYPES for a in self.outs)
+
+    def in_args (self):
+        return [(a.get ("type"), snake (a.get ("name") or "arg%d" % n))
+                for n, a in enumerate (self.ins)]
+
+    def in_fields (self):
+        fields = []
+        for sig, name in self.in_args ():
+            if sig == REFERENCE:
+                for member, suffix in REFERENCE_FIELDS:
+                    fields.append ((BASIC_TYPES[member], "%s_%s" % (name, suffix)))
+            else:
+                fields.append ((BASIC_TYPES[sig], name))
+        return fields
+
+    def out_fields (self):
+        fields = []
+        for n, a in enumerate (self.outs):
+            name = a.get ("name")
+            if not name:
+                name = "result" if n == 0 else "arg%d" % n
+            fields.append ((a.get ("type"), BASIC_TYPES[a.get ("type")], snake (name)))
+        return fields
+
+
+def read_methods (filenames):
+    interfaces = {}
+    order = []
+    for filename in filenames:
+        for iface in read_interfaces (filename):
+            name = iface.get ("name")
+            if name not in interfaces:
+                order.append (name)
+            interfaces[name] = iface
+    methods = []
+    for name in order:
+        if name in SKIPPED:
+            continue
+        for element in interfaces[name].findall ("method"):
+            methods.append (Method (interfaces[name], element))
+    return methods
+
+
+def reply_params (method, indent):
+    params = ["DBusMessage *message"]
+    for sig, (ctype, _), name in method.out_fields ():
+        params.append ("%s%s%s" % (ctype, "" if ctype.endswith ("*") else " ", name))
+    return (",\n" + " " * indent).join (params)
+
+
+def write_header (methods, out):
+    out.write (HEADER)
+    out.write ("\n#ifndef SPI_METHOD_ARGS_H_\n#define SPI_METHOD_ARGS_H_\n\n")
+    out.write ("#include <dbus/dbus.h>\n\n")
+
+    out.write ("/* Signatures of the input arguments, checked by droute */\n\n")
+    for m in methods:
+        out.write ('#define %s_SIGNATURE "%s"\n' % (m.prefix.upper (), m.signature))
+    out.write ("\n")
+
+    for m in methods:
+        if m.decodable ():
+            out.write ("typedef struct\n{\n")
+            for (ctype, _), name in m.in_fields ():
+                sep = "" if ctype.endswith ("*") else " "
+                out.write ("  %s%s%s;\n" % (ctype, sep, name))
+            out.write ("} %s;\n\n" % m.struct)
+            out.write ("void %s_decode (DBusMessage *message, %s *args);\n\n"
+                       % (m.prefix, m.struct))
+        if m.outs and m.encodable ():
+            out.write ("DBusMessage *%s_reply (%s);\n\n"
+                       % (m.prefix, reply_params (m, len (m.prefix) + 21)))
+
+    out.write ("#endif /* SPI_METHOD_ARGS_H_ */\n")
+
+
+def write_source (methods, out):
+    out.write (HEADER)
+    out.write ('\n#include "method-args.h"\n')
+    out.write ("\n/*\n * Decoders do not check types: droute has already "
+               "compared the message\n * signature with the one given in "
+               "the method table.\n */\n")
+
+    for m in methods:
+        if m.decodable ():
+            out.write ("\nvoid\n%s_decode (DBusMessage *message, %s *args)\n{\n"
+                       % (m.prefix, m.struct))
+            args = m.in_args ()
+            if any (sig == REFERENCE for sig, _ in args):
+                out.write ("  DBusMessageIter iter, iter_struct;\n\n")
+            else:
+                out.write ("  DBusMessageIter iter;\n\n")
+            out.write ("  dbus_message_iter_init (message, &iter);\n")
+            for n, (sig, name) in enumerate (args):
+                if sig == REFERENCE:
+                    out.write ("  dbus_message_iter_recurse (&iter, &iter_struct);\n")
+                    for i, (_, suffix) in enumerate (REFERENCE_FIELDS):
+                        if i:
+                            out.write ("  dbus_message_iter_next (&iter_struct);\n")
+                        out.write ("  dbus_message_iter_get_basic (&iter_struct, &args->%s_%s);\n"
+                                   % (name, suffix))
+                else:
+                    out.write ("  dbus_message_iter_get_basic (&iter, &args->%s);\n" % name)
+                if n + 1 < len (args):
+                    out.write ("  dbus_message_iter_next (&iter);\n")
+            out.write ("}\n")
+
+        if m.outs and m.encodable ():
+            out.write ("\nDBusMessage *\n%s_reply (%s)\n{\n"
+                       % (m.prefix, reply_params (m, len (m.prefix) + 8)))
+            out.write ("  DBusMessage *reply;\n  DBusMessageIter iter;\n\n")
+            for sig, _, name in m.out_fields ():
+                if sig == "s":
+                    out.write ('  if (!%s)\n    %s = "";\n' % (name, name))
+            out.write ("  reply = dbus_message_new_method_return (message);\n")
+            out.write ("  if (reply)\n    {\n")
+            out.write ("      dbus_message_iter_init_append (reply, &iter);\n")
+            for sig, (_, dbus_type), name in m.out_fields ():
+                out.write ("      dbus_message_iter_append_basic (&iter, %s, &%s);\n"
+                           % (dbus_type, name))
+            out.write ("    }\n  return reply;\n}\n")
+
+
+def main (argv):
+    if len (argv) < 4:
+        sys.stderr.write ("usage: %s introspection.c... method-args.h method-args.c\n" % argv[0])
+        return 1
+    methods = read_methods (argv[1:-2])
+    with open (argv[-2], "w") as out:
+        write_header (methods, out)
+    with open (argv[-1], "w") as out:
+        write_source (methods, out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit (main (sys.argv))
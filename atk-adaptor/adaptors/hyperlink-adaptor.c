@@ -29,6 +29,7 @@
 #include "spi-dbus.h"
 #include "introspection.h"
 #include "object.h"
+#include "method-args.h"
 
 static AtkHyperlink *
 get_hyperlink (void *user_data)
@@ -133,9 +134,9 @@ impl_IsValid (DBusConnection * bus, DBusMessage * message, void *user_data)
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetObject, "GetObject"},
-  {impl_GetURI, "GetURI"},
-  {impl_IsValid, "IsValid"},
+  {impl_GetObject, "GetObject", SPI_HYPERLINK_GET_OBJECT_SIGNATURE},
+  {impl_GetURI, "GetURI", SPI_HYPERLINK_GET_URI_SIGNATURE},
+  {impl_IsValid, "IsValid", SPI_HYPERLINK_IS_VALID_SIGNATURE},
   {NULL, NULL}
 };
 
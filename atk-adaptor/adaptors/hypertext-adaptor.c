@@ -30,6 +30,7 @@
 #include "object.h"
 
 #include "introspection.h"
+#include "method-args.h"
 
 static DBusMessage *
 impl_GetNLinks (DBusConnection * bus, DBusMessage * message, void *user_data)
@@ -98,9 +99,9 @@ impl_GetLinkIndex (DBusConnection * bus, DBusMessage * message,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetNLinks, "GetNLinks"},
-  {impl_GetLink, "GetLink"},
-  {impl_GetLinkIndex, "GetLinkIndex"},
+  {impl_GetNLinks, "GetNLinks", SPI_HYPERTEXT_GET_N_LINKS_SIGNATURE},
+  {impl_GetLink, "GetLink", SPI_HYPERTEXT_GET_LINK_SIGNATURE},
+  {impl_GetLinkIndex, "GetLinkIndex", SPI_HYPERTEXT_GET_LINK_INDEX_SIGNATURE},
   {NULL, NULL}
 };
 
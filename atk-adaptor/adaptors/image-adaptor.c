@@ -29,6 +29,7 @@
 #include "spi-dbus.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_ImageDescription (DBusMessageIter * iter, void *user_data)
@@ -120,9 +121,9 @@ impl_GetImageSize (DBusConnection * bus, DBusMessage * message,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetImageExtents, "GetImageExtents"},
-  {impl_GetImagePosition, "GetImagePosition"},
-  {impl_GetImageSize, "GetImageSize"},
+  {impl_GetImageExtents, "GetImageExtents", SPI_IMAGE_GET_IMAGE_EXTENTS_SIGNATURE},
+  {impl_GetImagePosition, "GetImagePosition", SPI_IMAGE_GET_IMAGE_POSITION_SIGNATURE},
+  {impl_GetImageSize, "GetImageSize", SPI_IMAGE_GET_IMAGE_SIZE_SIGNATURE},
   {NULL, NULL}
 };
 
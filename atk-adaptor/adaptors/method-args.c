@@ -0,0 +1,1987 @@
+/*
+ * This file has been generated by gen-method-args.py from the
+ * introspection data in introspection.c and introspection-bridge.c.
+ *
+ * DO NOT EDIT.
+ */
+
+#include "method-args.h"
+
+/*
+ * Decoders do not check types: droute has already compared the message
+ * signature with the one given in the method table.
+ */
+
+void
+spi_accessible_get_child_at_index_decode (DBusMessage *message, SpiAccessibleGetChildAtIndexArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_accessible_get_index_in_parent_reply (DBusMessage *message,
+                                          dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_accessible_get_role_reply (DBusMessage *message,
+                               dbus_uint32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_UINT32, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_accessible_get_role_name_reply (DBusMessage *message,
+                                    const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_accessible_get_localized_role_name_reply (DBusMessage *message,
+                                              const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_action_get_description_decode (DBusMessage *message, SpiActionGetDescriptionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_action_get_description_reply (DBusMessage *message,
+                                  const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_action_get_name_decode (DBusMessage *message, SpiActionGetNameArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_action_get_name_reply (DBusMessage *message,
+                           const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_action_get_localized_name_decode (DBusMessage *message, SpiActionGetLocalizedNameArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_action_get_localized_name_reply (DBusMessage *message,
+                                     const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_action_get_key_binding_decode (DBusMessage *message, SpiActionGetKeyBindingArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_action_get_key_binding_reply (DBusMessage *message,
+                                  const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_action_do_action_decode (DBusMessage *message, SpiActionDoActionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_action_do_action_reply (DBusMessage *message,
+                            dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_application_get_locale_decode (DBusMessage *message, SpiApplicationGetLocaleArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->lctype);
+}
+
+DBusMessage *
+spi_application_get_locale_reply (DBusMessage *message,
+                                  const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_application_register_event_listener_decode (DBusMessage *message, SpiApplicationRegisterEventListenerArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->event);
+}
+
+void
+spi_application_deregister_event_listener_decode (DBusMessage *message, SpiApplicationDeregisterEventListenerArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->event);
+}
+
+void
+spi_component_contains_decode (DBusMessage *message, SpiComponentContainsArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->x);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->y);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_component_contains_reply (DBusMessage *message,
+                              dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_component_get_accessible_at_point_decode (DBusMessage *message, SpiComponentGetAccessibleAtPointArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->x);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->y);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+void
+spi_component_get_extents_decode (DBusMessage *message, SpiComponentGetExtentsArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+void
+spi_component_get_position_decode (DBusMessage *message, SpiComponentGetPositionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_component_get_position_reply (DBusMessage *message,
+                                  dbus_int32_t x,
+                                  dbus_int32_t y)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &x);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &y);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_component_get_size_reply (DBusMessage *message,
+                              dbus_int32_t width,
+                              dbus_int32_t height)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &width);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &height);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_component_get_layer_reply (DBusMessage *message,
+                               dbus_uint32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_UINT32, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_component_get_mdiz_order_reply (DBusMessage *message,
+                                    dbus_int16_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT16, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_component_grab_focus_reply (DBusMessage *message,
+                                dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_component_get_alpha_reply (DBusMessage *message,
+                               double result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_DOUBLE, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_component_set_extents_reply (DBusMessage *message,
+                                 dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_component_set_position_decode (DBusMessage *message, SpiComponentSetPositionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->x);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->y);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_component_set_position_reply (DBusMessage *message,
+                                  dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_component_set_size_decode (DBusMessage *message, SpiComponentSetSizeArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->width);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->height);
+}
+
+DBusMessage *
+spi_component_set_size_reply (DBusMessage *message,
+                              dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_document_get_locale_reply (DBusMessage *message,
+                               const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_document_get_attribute_value_decode (DBusMessage *message, SpiDocumentGetAttributeValueArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->attributename);
+}
+
+DBusMessage *
+spi_document_get_attribute_value_reply (DBusMessage *message,
+                                        const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_hypertext_get_n_links_reply (DBusMessage *message,
+                                 dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_hypertext_get_link_decode (DBusMessage *message, SpiHypertextGetLinkArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->link_index);
+}
+
+void
+spi_hypertext_get_link_index_decode (DBusMessage *message, SpiHypertextGetLinkIndexArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->character_index);
+}
+
+DBusMessage *
+spi_hypertext_get_link_index_reply (DBusMessage *message,
+                                    dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_hyperlink_get_object_decode (DBusMessage *message, SpiHyperlinkGetObjectArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->i);
+}
+
+void
+spi_hyperlink_get_uri_decode (DBusMessage *message, SpiHyperlinkGetURIArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->i);
+}
+
+DBusMessage *
+spi_hyperlink_get_uri_reply (DBusMessage *message,
+                             const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_hyperlink_is_valid_reply (DBusMessage *message,
+                              dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_image_get_image_extents_decode (DBusMessage *message, SpiImageGetImageExtentsArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+void
+spi_image_get_image_position_decode (DBusMessage *message, SpiImageGetImagePositionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_image_get_image_position_reply (DBusMessage *message,
+                                    dbus_int32_t x,
+                                    dbus_int32_t y)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &x);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &y);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_image_get_image_size_reply (DBusMessage *message,
+                                dbus_int32_t width,
+                                dbus_int32_t height)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &width);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &height);
+    }
+  return reply;
+}
+
+void
+spi_selection_get_selected_child_decode (DBusMessage *message, SpiSelectionGetSelectedChildArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->selected_child_index);
+}
+
+void
+spi_selection_select_child_decode (DBusMessage *message, SpiSelectionSelectChildArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->child_index);
+}
+
+DBusMessage *
+spi_selection_select_child_reply (DBusMessage *message,
+                                  dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_selection_deselect_selected_child_decode (DBusMessage *message, SpiSelectionDeselectSelectedChildArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->selected_child_index);
+}
+
+DBusMessage *
+spi_selection_deselect_selected_child_reply (DBusMessage *message,
+                                             dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_selection_is_child_selected_decode (DBusMessage *message, SpiSelectionIsChildSelectedArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->child_index);
+}
+
+DBusMessage *
+spi_selection_is_child_selected_reply (DBusMessage *message,
+                                       dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_selection_select_all_reply (DBusMessage *message,
+                                dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_selection_clear_selection_reply (DBusMessage *message,
+                                     dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_selection_deselect_child_decode (DBusMessage *message, SpiSelectionDeselectChildArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->child_index);
+}
+
+DBusMessage *
+spi_selection_deselect_child_reply (DBusMessage *message,
+                                    dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_accessible_at_decode (DBusMessage *message, SpiTableGetAccessibleAtArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+void
+spi_table_get_index_at_decode (DBusMessage *message, SpiTableGetIndexAtArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_get_index_at_reply (DBusMessage *message,
+                              dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_row_at_index_decode (DBusMessage *message, SpiTableGetRowAtIndexArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_table_get_row_at_index_reply (DBusMessage *message,
+                                  dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_column_at_index_decode (DBusMessage *message, SpiTableGetColumnAtIndexArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_table_get_column_at_index_reply (DBusMessage *message,
+                                     dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_row_description_decode (DBusMessage *message, SpiTableGetRowDescriptionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+}
+
+DBusMessage *
+spi_table_get_row_description_reply (DBusMessage *message,
+                                     const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_column_description_decode (DBusMessage *message, SpiTableGetColumnDescriptionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_get_column_description_reply (DBusMessage *message,
+                                        const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_row_extent_at_decode (DBusMessage *message, SpiTableGetRowExtentAtArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_get_row_extent_at_reply (DBusMessage *message,
+                                   dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_column_extent_at_decode (DBusMessage *message, SpiTableGetColumnExtentAtArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_get_column_extent_at_reply (DBusMessage *message,
+                                      dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_row_header_decode (DBusMessage *message, SpiTableGetRowHeaderArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+}
+
+void
+spi_table_get_column_header_decode (DBusMessage *message, SpiTableGetColumnHeaderArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+void
+spi_table_is_row_selected_decode (DBusMessage *message, SpiTableIsRowSelectedArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+}
+
+DBusMessage *
+spi_table_is_row_selected_reply (DBusMessage *message,
+                                 dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_is_column_selected_decode (DBusMessage *message, SpiTableIsColumnSelectedArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_is_column_selected_reply (DBusMessage *message,
+                                    dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_is_selected_decode (DBusMessage *message, SpiTableIsSelectedArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_is_selected_reply (DBusMessage *message,
+                             dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_add_row_selection_decode (DBusMessage *message, SpiTableAddRowSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+}
+
+DBusMessage *
+spi_table_add_row_selection_reply (DBusMessage *message,
+                                   dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_add_column_selection_decode (DBusMessage *message, SpiTableAddColumnSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_add_column_selection_reply (DBusMessage *message,
+                                      dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_remove_row_selection_decode (DBusMessage *message, SpiTableRemoveRowSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->row);
+}
+
+DBusMessage *
+spi_table_remove_row_selection_reply (DBusMessage *message,
+                                      dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_remove_column_selection_decode (DBusMessage *message, SpiTableRemoveColumnSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->column);
+}
+
+DBusMessage *
+spi_table_remove_column_selection_reply (DBusMessage *message,
+                                         dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_table_get_row_column_extents_at_index_decode (DBusMessage *message, SpiTableGetRowColumnExtentsAtIndexArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->index);
+}
+
+DBusMessage *
+spi_table_get_row_column_extents_at_index_reply (DBusMessage *message,
+                                                 dbus_bool_t result,
+                                                 dbus_int32_t row,
+                                                 dbus_int32_t col,
+                                                 dbus_int32_t row_extents,
+                                                 dbus_int32_t col_extents,
+                                                 dbus_bool_t is_selected)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &row);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &col);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &row_extents);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &col_extents);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &is_selected);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_table_cell_get_row_column_span_reply (DBusMessage *message,
+                                          dbus_bool_t result,
+                                          dbus_int32_t row,
+                                          dbus_int32_t col,
+                                          dbus_int32_t row_extents,
+                                          dbus_int32_t col_extents)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &row);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &col);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &row_extents);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &col_extents);
+    }
+  return reply;
+}
+
+void
+spi_text_get_string_at_offset_decode (DBusMessage *message, SpiTextGetStringAtOffsetArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->granularity);
+}
+
+DBusMessage *
+spi_text_get_string_at_offset_reply (DBusMessage *message,
+                                     const char *result,
+                                     dbus_int32_t start_offset,
+                                     dbus_int32_t end_offset)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &start_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &end_offset);
+    }
+  return reply;
+}
+
+void
+spi_text_get_text_decode (DBusMessage *message, SpiTextGetTextArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->start_offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_offset);
+}
+
+DBusMessage *
+spi_text_get_text_reply (DBusMessage *message,
+                         const char *result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_set_caret_offset_decode (DBusMessage *message, SpiTextSetCaretOffsetArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+}
+
+DBusMessage *
+spi_text_set_caret_offset_reply (DBusMessage *message,
+                                 dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_get_text_before_offset_decode (DBusMessage *message, SpiTextGetTextBeforeOffsetArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->type);
+}
+
+DBusMessage *
+spi_text_get_text_before_offset_reply (DBusMessage *message,
+                                       const char *result,
+                                       dbus_int32_t start_offset,
+                                       dbus_int32_t end_offset)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &start_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &end_offset);
+    }
+  return reply;
+}
+
+void
+spi_text_get_text_at_offset_decode (DBusMessage *message, SpiTextGetTextAtOffsetArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->type);
+}
+
+DBusMessage *
+spi_text_get_text_at_offset_reply (DBusMessage *message,
+                                   const char *result,
+                                   dbus_int32_t start_offset,
+                                   dbus_int32_t end_offset)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &start_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &end_offset);
+    }
+  return reply;
+}
+
+void
+spi_text_get_text_after_offset_decode (DBusMessage *message, SpiTextGetTextAfterOffsetArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->type);
+}
+
+DBusMessage *
+spi_text_get_text_after_offset_reply (DBusMessage *message,
+                                      const char *result,
+                                      dbus_int32_t start_offset,
+                                      dbus_int32_t end_offset)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &start_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &end_offset);
+    }
+  return reply;
+}
+
+void
+spi_text_get_character_at_offset_decode (DBusMessage *message, SpiTextGetCharacterAtOffsetArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+}
+
+DBusMessage *
+spi_text_get_character_at_offset_reply (DBusMessage *message,
+                                        dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_get_attribute_value_decode (DBusMessage *message, SpiTextGetAttributeValueArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->attribute_name);
+}
+
+DBusMessage *
+spi_text_get_attribute_value_reply (DBusMessage *message,
+                                    const char *result,
+                                    dbus_int32_t start_offset,
+                                    dbus_int32_t end_offset,
+                                    dbus_bool_t defined)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  if (!result)
+    result = "";
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_STRING, &result);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &start_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &end_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &defined);
+    }
+  return reply;
+}
+
+void
+spi_text_get_attributes_decode (DBusMessage *message, SpiTextGetAttributesArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+}
+
+void
+spi_text_get_character_extents_decode (DBusMessage *message, SpiTextGetCharacterExtentsArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_text_get_character_extents_reply (DBusMessage *message,
+                                      dbus_int32_t x,
+                                      dbus_int32_t y,
+                                      dbus_int32_t width,
+                                      dbus_int32_t height)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &x);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &y);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &width);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &height);
+    }
+  return reply;
+}
+
+void
+spi_text_get_offset_at_point_decode (DBusMessage *message, SpiTextGetOffsetAtPointArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->x);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->y);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_text_get_offset_at_point_reply (DBusMessage *message,
+                                    dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+DBusMessage *
+spi_text_get_n_selections_reply (DBusMessage *message,
+                                 dbus_int32_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_get_selection_decode (DBusMessage *message, SpiTextGetSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->selection_num);
+}
+
+DBusMessage *
+spi_text_get_selection_reply (DBusMessage *message,
+                              dbus_int32_t start_offset,
+                              dbus_int32_t end_offset)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &start_offset);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &end_offset);
+    }
+  return reply;
+}
+
+void
+spi_text_add_selection_decode (DBusMessage *message, SpiTextAddSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->start_offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_offset);
+}
+
+DBusMessage *
+spi_text_add_selection_reply (DBusMessage *message,
+                              dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_remove_selection_decode (DBusMessage *message, SpiTextRemoveSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->selection_num);
+}
+
+DBusMessage *
+spi_text_remove_selection_reply (DBusMessage *message,
+                                 dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_set_selection_decode (DBusMessage *message, SpiTextSetSelectionArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->selection_num);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->start_offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_offset);
+}
+
+DBusMessage *
+spi_text_set_selection_reply (DBusMessage *message,
+                              dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_text_get_range_extents_decode (DBusMessage *message, SpiTextGetRangeExtentsArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->start_offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+}
+
+DBusMessage *
+spi_text_get_range_extents_reply (DBusMessage *message,
+                                  dbus_int32_t x,
+                                  dbus_int32_t y,
+                                  dbus_int32_t width,
+                                  dbus_int32_t height)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &x);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &y);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &width);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_INT32, &height);
+    }
+  return reply;
+}
+
+void
+spi_text_get_bounded_ranges_decode (DBusMessage *message, SpiTextGetBoundedRangesArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->x);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->y);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->width);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->height);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->coord_type);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->x_clip_type);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->y_clip_type);
+}
+
+void
+spi_text_get_attribute_run_decode (DBusMessage *message, SpiTextGetAttributeRunArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->offset);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->include_defaults);
+}
+
+void
+spi_editable_text_set_text_contents_decode (DBusMessage *message, SpiEditableTextSetTextContentsArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->new_contents);
+}
+
+DBusMessage *
+spi_editable_text_set_text_contents_reply (DBusMessage *message,
+                                           dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_editable_text_insert_text_decode (DBusMessage *message, SpiEditableTextInsertTextArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->position);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->text);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->length);
+}
+
+DBusMessage *
+spi_editable_text_insert_text_reply (DBusMessage *message,
+                                     dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_editable_text_copy_text_decode (DBusMessage *message, SpiEditableTextCopyTextArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->start_pos);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_pos);
+}
+
+void
+spi_editable_text_cut_text_decode (DBusMessage *message, SpiEditableTextCutTextArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->start_pos);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_pos);
+}
+
+DBusMessage *
+spi_editable_text_cut_text_reply (DBusMessage *message,
+                                  dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_editable_text_delete_text_decode (DBusMessage *message, SpiEditableTextDeleteTextArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->start_pos);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->end_pos);
+}
+
+DBusMessage *
+spi_editable_text_delete_text_reply (DBusMessage *message,
+                                     dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_editable_text_paste_text_decode (DBusMessage *message, SpiEditableTextPasteTextArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->position);
+}
+
+DBusMessage *
+spi_editable_text_paste_text_reply (DBusMessage *message,
+                                    dbus_bool_t result)
+{
+  DBusMessage *reply;
+  DBusMessageIter iter;
+
+  reply = dbus_message_new_method_return (message);
+  if (reply)
+    {
+      dbus_message_iter_init_append (reply, &iter);
+      dbus_message_iter_append_basic (&iter, DBUS_TYPE_BOOLEAN, &result);
+    }
+  return reply;
+}
+
+void
+spi_cache_get_items_compact_decode (DBusMessage *message, SpiCacheGetItemsCompactArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->fields);
+}
+
+void
+spi_cache_get_items_for_subtree_decode (DBusMessage *message, SpiCacheGetItemsForSubtreeArgs *args)
+{
+  DBusMessageIter iter, iter_struct;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_recurse (&iter, &iter_struct);
+  dbus_message_iter_get_basic (&iter_struct, &args->root_bus_name);
+  dbus_message_iter_next (&iter_struct);
+  dbus_message_iter_get_basic (&iter_struct, &args->root_path);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->max_depth);
+}
+
+void
+spi_cache_get_items_page_decode (DBusMessage *message, SpiCacheGetItemsPageArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->cursor);
+  dbus_message_iter_next (&iter);
+  dbus_message_iter_get_basic (&iter, &args->max_items);
+}
+
+void
+spi_cache_get_items_since_decode (DBusMessage *message, SpiCacheGetItemsSinceArgs *args)
+{
+  DBusMessageIter iter;
+
+  dbus_message_iter_init (message, &iter);
+  dbus_message_iter_get_basic (&iter, &args->generation);
+}
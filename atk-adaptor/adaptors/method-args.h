@@ -0,0 +1,919 @@
+/*
+ * This file has been generated by gen-method-args.py from the
+ * introspection data in introspection.c and introspection-bridge.c.
+ *
+ * DO NOT EDIT.
+ */
+
+#ifndef SPI_METHOD_ARGS_H_
+#define SPI_METHOD_ARGS_H_
+
+#include <dbus/dbus.h>
+
+/* Signatures of the input arguments, checked by droute */
+
+#define SPI_ACCESSIBLE_GET_CHILD_AT_INDEX_SIGNATURE "i"
+#define SPI_ACCESSIBLE_GET_CHILDREN_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_INDEX_IN_PARENT_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_RELATION_SET_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_ROLE_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_ROLE_NAME_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_LOCALIZED_ROLE_NAME_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_STATE_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_ATTRIBUTES_SIGNATURE ""
+#define SPI_ACCESSIBLE_GET_APPLICATION_SIGNATURE ""
+#define SPI_ACTION_GET_DESCRIPTION_SIGNATURE "i"
+#define SPI_ACTION_GET_NAME_SIGNATURE "i"
+#define SPI_ACTION_GET_LOCALIZED_NAME_SIGNATURE "i"
+#define SPI_ACTION_GET_KEY_BINDING_SIGNATURE "i"
+#define SPI_ACTION_GET_ACTIONS_SIGNATURE ""
+#define SPI_ACTION_DO_ACTION_SIGNATURE "i"
+#define SPI_APPLICATION_GET_LOCALE_SIGNATURE "u"
+#define SPI_APPLICATION_REGISTER_EVENT_LISTENER_SIGNATURE "s"
+#define SPI_APPLICATION_DEREGISTER_EVENT_LISTENER_SIGNATURE "s"
+#define SPI_COLLECTION_GET_MATCHES_SIGNATURE "(aiia{ss}iaiiasib)uib"
+#define SPI_COLLECTION_GET_MATCHES_TO_SIGNATURE "o(aiia{ss}iaiiasib)uubib"
+#define SPI_COLLECTION_GET_MATCHES_FROM_SIGNATURE "o(aiia{ss}iaiiasib)uuib"
+#define SPI_COLLECTION_GET_ACTIVE_DESCENDANT_SIGNATURE ""
+#define SPI_COMPONENT_CONTAINS_SIGNATURE "iiu"
+#define SPI_COMPONENT_GET_ACCESSIBLE_AT_POINT_SIGNATURE "iiu"
+#define SPI_COMPONENT_GET_EXTENTS_SIGNATURE "u"
+#define SPI_COMPONENT_GET_POSITION_SIGNATURE "u"
+#define SPI_COMPONENT_GET_SIZE_SIGNATURE ""
+#define SPI_COMPONENT_GET_LAYER_SIGNATURE ""
+#define SPI_COMPONENT_GET_MDIZ_ORDER_SIGNATURE ""
+#define SPI_COMPONENT_GRAB_FOCUS_SIGNATURE ""
+#define SPI_COMPONENT_GET_ALPHA_SIGNATURE ""
+#define SPI_COMPONENT_SET_EXTENTS_SIGNATURE "(iiii)u"
+#define SPI_COMPONENT_SET_POSITION_SIGNATURE "iiu"
+#define SPI_COMPONENT_SET_SIZE_SIGNATURE "ii"
+#define SPI_DOCUMENT_GET_LOCALE_SIGNATURE ""
+#define SPI_DOCUMENT_GET_ATTRIBUTE_VALUE_SIGNATURE "s"
+#define SPI_DOCUMENT_GET_ATTRIBUTES_SIGNATURE ""
+#define SPI_HYPERTEXT_GET_N_LINKS_SIGNATURE ""
+#define SPI_HYPERTEXT_GET_LINK_SIGNATURE "i"
+#define SPI_HYPERTEXT_GET_LINK_INDEX_SIGNATURE "i"
+#define SPI_HYPERLINK_GET_OBJECT_SIGNATURE "i"
+#define SPI_HYPERLINK_GET_URI_SIGNATURE "i"
+#define SPI_HYPERLINK_IS_VALID_SIGNATURE ""
+#define SPI_IMAGE_GET_IMAGE_EXTENTS_SIGNATURE "u"
+#define SPI_IMAGE_GET_IMAGE_POSITION_SIGNATURE "u"
+#define SPI_IMAGE_GET_IMAGE_SIZE_SIGNATURE ""
+#define SPI_SELECTION_GET_SELECTED_CHILD_SIGNATURE "i"
+#define SPI_SELECTION_SELECT_CHILD_SIGNATURE "i"
+#define SPI_SELECTION_DESELECT_SELECTED_CHILD_SIGNATURE "i"
+#define SPI_SELECTION_IS_CHILD_SELECTED_SIGNATURE "i"
+#define SPI_SELECTION_SELECT_ALL_SIGNATURE ""
+#define SPI_SELECTION_CLEAR_SELECTION_SIGNATURE ""
+#define SPI_SELECTION_DESELECT_CHILD_SIGNATURE "i"
+#define SPI_TABLE_GET_ACCESSIBLE_AT_SIGNATURE "ii"
+#define SPI_TABLE_GET_INDEX_AT_SIGNATURE "ii"
+#define SPI_TABLE_GET_ROW_AT_INDEX_SIGNATURE "i"
+#define SPI_TABLE_GET_COLUMN_AT_INDEX_SIGNATURE "i"
+#define SPI_TABLE_GET_ROW_DESCRIPTION_SIGNATURE "i"
+#define SPI_TABLE_GET_COLUMN_DESCRIPTION_SIGNATURE "i"
+#define SPI_TABLE_GET_ROW_EXTENT_AT_SIGNATURE "ii"
+#define SPI_TABLE_GET_COLUMN_EXTENT_AT_SIGNATURE "ii"
+#define SPI_TABLE_GET_ROW_HEADER_SIGNATURE "i"
+#define SPI_TABLE_GET_COLUMN_HEADER_SIGNATURE "i"
+#define SPI_TABLE_GET_SELECTED_ROWS_SIGNATURE ""
+#define SPI_TABLE_GET_SELECTED_COLUMNS_SIGNATURE ""
+#define SPI_TABLE_IS_ROW_SELECTED_SIGNATURE "i"
+#define SPI_TABLE_IS_COLUMN_SELECTED_SIGNATURE "i"
+#define SPI_TABLE_IS_SELECTED_SIGNATURE "ii"
+#define SPI_TABLE_ADD_ROW_SELECTION_SIGNATURE "i"
+#define SPI_TABLE_ADD_COLUMN_SELECTION_SIGNATURE "i"
+#define SPI_TABLE_REMOVE_ROW_SELECTION_SIGNATURE "i"
+#define SPI_TABLE_REMOVE_COLUMN_SELECTION_SIGNATURE "i"
+#define SPI_TABLE_GET_ROW_COLUMN_EXTENTS_AT_INDEX_SIGNATURE "i"
+#define SPI_TABLE_CELL_GET_ROW_COLUMN_SPAN_SIGNATURE ""
+#define SPI_TEXT_GET_STRING_AT_OFFSET_SIGNATURE "iu"
+#define SPI_TEXT_GET_TEXT_SIGNATURE "ii"
+#define SPI_TEXT_SET_CARET_OFFSET_SIGNATURE "i"
+#define SPI_TEXT_GET_TEXT_BEFORE_OFFSET_SIGNATURE "iu"
+#define SPI_TEXT_GET_TEXT_AT_OFFSET_SIGNATURE "iu"
+#define SPI_TEXT_GET_TEXT_AFTER_OFFSET_SIGNATURE "iu"
+#define SPI_TEXT_GET_CHARACTER_AT_OFFSET_SIGNATURE "i"
+#define SPI_TEXT_GET_ATTRIBUTE_VALUE_SIGNATURE "is"
+#define SPI_TEXT_GET_ATTRIBUTES_SIGNATURE "i"
+#define SPI_TEXT_GET_DEFAULT_ATTRIBUTES_SIGNATURE ""
+#define SPI_TEXT_GET_CHARACTER_EXTENTS_SIGNATURE "iu"
+#define SPI_TEXT_GET_OFFSET_AT_POINT_SIGNATURE "iiu"
+#define SPI_TEXT_GET_N_SELECTIONS_SIGNATURE ""
+#define SPI_TEXT_GET_SELECTION_SIGNATURE "i"
+#define SPI_TEXT_ADD_SELECTION_SIGNATURE "ii"
+#define SPI_TEXT_REMOVE_SELECTION_SIGNATURE "i"
+#define SPI_TEXT_SET_SELECTION_SIGNATURE "iii"
+#define SPI_TEXT_GET_RANGE_EXTENTS_SIGNATURE "iiu"
+#define SPI_TEXT_GET_BOUNDED_RANGES_SIGNATURE "iiiiuuu"
+#define SPI_TEXT_GET_ATTRIBUTE_RUN_SIGNATURE "ib"
+#define SPI_TEXT_GET_DEFAULT_ATTRIBUTE_SET_SIGNATURE ""
+#define SPI_EDITABLE_TEXT_SET_TEXT_CONTENTS_SIGNATURE "s"
+#define SPI_EDITABLE_TEXT_INSERT_TEXT_SIGNATURE "isi"
+#define SPI_EDITABLE_TEXT_COPY_TEXT_SIGNATURE "ii"
+#define SPI_EDITABLE_TEXT_CUT_TEXT_SIGNATURE "ii"
+#define SPI_EDITABLE_TEXT_DELETE_TEXT_SIGNATURE "ii"
+#define SPI_EDITABLE_TEXT_PASTE_TEXT_SIGNATURE "i"
+#define SPI_CACHE_GET_ITEMS_SIGNATURE ""
+#define SPI_CACHE_GET_ITEMS_COMPACT_SIGNATURE "u"
+#define SPI_CACHE_GET_ITEMS_FOR_SUBTREE_SIGNATURE "(so)u"
+#define SPI_CACHE_GET_ITEMS_PAGE_SIGNATURE "uu"
+#define SPI_CACHE_GET_ITEMS_SINCE_SIGNATURE "u"
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiAccessibleGetChildAtIndexArgs;
+
+void spi_accessible_get_child_at_index_decode (DBusMessage *message, SpiAccessibleGetChildAtIndexArgs *args);
+
+DBusMessage *spi_accessible_get_index_in_parent_reply (DBusMessage *message,
+                                                       dbus_int32_t result);
+
+DBusMessage *spi_accessible_get_role_reply (DBusMessage *message,
+                                            dbus_uint32_t result);
+
+DBusMessage *spi_accessible_get_role_name_reply (DBusMessage *message,
+                                                 const char *result);
+
+DBusMessage *spi_accessible_get_localized_role_name_reply (DBusMessage *message,
+                                                           const char *result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiActionGetDescriptionArgs;
+
+void spi_action_get_description_decode (DBusMessage *message, SpiActionGetDescriptionArgs *args);
+
+DBusMessage *spi_action_get_description_reply (DBusMessage *message,
+                                               const char *result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiActionGetNameArgs;
+
+void spi_action_get_name_decode (DBusMessage *message, SpiActionGetNameArgs *args);
+
+DBusMessage *spi_action_get_name_reply (DBusMessage *message,
+                                        const char *result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiActionGetLocalizedNameArgs;
+
+void spi_action_get_localized_name_decode (DBusMessage *message, SpiActionGetLocalizedNameArgs *args);
+
+DBusMessage *spi_action_get_localized_name_reply (DBusMessage *message,
+                                                  const char *result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiActionGetKeyBindingArgs;
+
+void spi_action_get_key_binding_decode (DBusMessage *message, SpiActionGetKeyBindingArgs *args);
+
+DBusMessage *spi_action_get_key_binding_reply (DBusMessage *message,
+                                               const char *result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiActionDoActionArgs;
+
+void spi_action_do_action_decode (DBusMessage *message, SpiActionDoActionArgs *args);
+
+DBusMessage *spi_action_do_action_reply (DBusMessage *message,
+                                         dbus_bool_t result);
+
+typedef struct
+{
+  dbus_uint32_t lctype;
+} SpiApplicationGetLocaleArgs;
+
+void spi_application_get_locale_decode (DBusMessage *message, SpiApplicationGetLocaleArgs *args);
+
+DBusMessage *spi_application_get_locale_reply (DBusMessage *message,
+                                               const char *result);
+
+typedef struct
+{
+  const char *event;
+} SpiApplicationRegisterEventListenerArgs;
+
+void spi_application_register_event_listener_decode (DBusMessage *message, SpiApplicationRegisterEventListenerArgs *args);
+
+typedef struct
+{
+  const char *event;
+} SpiApplicationDeregisterEventListenerArgs;
+
+void spi_application_deregister_event_listener_decode (DBusMessage *message, SpiApplicationDeregisterEventListenerArgs *args);
+
+typedef struct
+{
+  dbus_int32_t x;
+  dbus_int32_t y;
+  dbus_uint32_t coord_type;
+} SpiComponentContainsArgs;
+
+void spi_component_contains_decode (DBusMessage *message, SpiComponentContainsArgs *args);
+
+DBusMessage *spi_component_contains_reply (DBusMessage *message,
+                                           dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t x;
+  dbus_int32_t y;
+  dbus_uint32_t coord_type;
+} SpiComponentGetAccessibleAtPointArgs;
+
+void spi_component_get_accessible_at_point_decode (DBusMessage *message, SpiComponentGetAccessibleAtPointArgs *args);
+
+typedef struct
+{
+  dbus_uint32_t coord_type;
+} SpiComponentGetExtentsArgs;
+
+void spi_component_get_extents_decode (DBusMessage *message, SpiComponentGetExtentsArgs *args);
+
+typedef struct
+{
+  dbus_uint32_t coord_type;
+} SpiComponentGetPositionArgs;
+
+void spi_component_get_position_decode (DBusMessage *message, SpiComponentGetPositionArgs *args);
+
+DBusMessage *spi_component_get_position_reply (DBusMessage *message,
+                                               dbus_int32_t x,
+                                               dbus_int32_t y);
+
+DBusMessage *spi_component_get_size_reply (DBusMessage *message,
+                                           dbus_int32_t width,
+                                           dbus_int32_t height);
+
+DBusMessage *spi_component_get_layer_reply (DBusMessage *message,
+                                            dbus_uint32_t result);
+
+DBusMessage *spi_component_get_mdiz_order_reply (DBusMessage *message,
+                                                 dbus_int16_t result);
+
+DBusMessage *spi_component_grab_focus_reply (DBusMessage *message,
+                                             dbus_bool_t result);
+
+DBusMessage *spi_component_get_alpha_reply (DBusMessage *message,
+                                            double result);
+
+DBusMessage *spi_component_set_extents_reply (DBusMessage *message,
+                                              dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t x;
+  dbus_int32_t y;
+  dbus_uint32_t coord_type;
+} SpiComponentSetPositionArgs;
+
+void spi_component_set_position_decode (DBusMessage *message, SpiComponentSetPositionArgs *args);
+
+DBusMessage *spi_component_set_position_reply (DBusMessage *message,
+                                               dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t width;
+  dbus_int32_t height;
+} SpiComponentSetSizeArgs;
+
+void spi_component_set_size_decode (DBusMessage *message, SpiComponentSetSizeArgs *args);
+
+DBusMessage *spi_component_set_size_reply (DBusMessage *message,
+                                           dbus_bool_t result);
+
+DBusMessage *spi_document_get_locale_reply (DBusMessage *message,
+                                            const char *result);
+
+typedef struct
+{
+  const char *attributename;
+} SpiDocumentGetAttributeValueArgs;
+
+void spi_document_get_attribute_value_decode (DBusMessage *message, SpiDocumentGetAttributeValueArgs *args);
+
+DBusMessage *spi_document_get_attribute_value_reply (DBusMessage *message,
+                                                     const char *result);
+
+DBusMessage *spi_hypertext_get_n_links_reply (DBusMessage *message,
+                                              dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t link_index;
+} SpiHypertextGetLinkArgs;
+
+void spi_hypertext_get_link_decode (DBusMessage *message, SpiHypertextGetLinkArgs *args);
+
+typedef struct
+{
+  dbus_int32_t character_index;
+} SpiHypertextGetLinkIndexArgs;
+
+void spi_hypertext_get_link_index_decode (DBusMessage *message, SpiHypertextGetLinkIndexArgs *args);
+
+DBusMessage *spi_hypertext_get_link_index_reply (DBusMessage *message,
+                                                 dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t i;
+} SpiHyperlinkGetObjectArgs;
+
+void spi_hyperlink_get_object_decode (DBusMessage *message, SpiHyperlinkGetObjectArgs *args);
+
+typedef struct
+{
+  dbus_int32_t i;
+} SpiHyperlinkGetURIArgs;
+
+void spi_hyperlink_get_uri_decode (DBusMessage *message, SpiHyperlinkGetURIArgs *args);
+
+DBusMessage *spi_hyperlink_get_uri_reply (DBusMessage *message,
+                                          const char *result);
+
+DBusMessage *spi_hyperlink_is_valid_reply (DBusMessage *message,
+                                           dbus_bool_t result);
+
+typedef struct
+{
+  dbus_uint32_t coord_type;
+} SpiImageGetImageExtentsArgs;
+
+void spi_image_get_image_extents_decode (DBusMessage *message, SpiImageGetImageExtentsArgs *args);
+
+typedef struct
+{
+  dbus_uint32_t coord_type;
+} SpiImageGetImagePositionArgs;
+
+void spi_image_get_image_position_decode (DBusMessage *message, SpiImageGetImagePositionArgs *args);
+
+DBusMessage *spi_image_get_image_position_reply (DBusMessage *message,
+                                                 dbus_int32_t x,
+                                                 dbus_int32_t y);
+
+DBusMessage *spi_image_get_image_size_reply (DBusMessage *message,
+                                             dbus_int32_t width,
+                                             dbus_int32_t height);
+
+typedef struct
+{
+  dbus_int32_t selected_child_index;
+} SpiSelectionGetSelectedChildArgs;
+
+void spi_selection_get_selected_child_decode (DBusMessage *message, SpiSelectionGetSelectedChildArgs *args);
+
+typedef struct
+{
+  dbus_int32_t child_index;
+} SpiSelectionSelectChildArgs;
+
+void spi_selection_select_child_decode (DBusMessage *message, SpiSelectionSelectChildArgs *args);
+
+DBusMessage *spi_selection_select_child_reply (DBusMessage *message,
+                                               dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t selected_child_index;
+} SpiSelectionDeselectSelectedChildArgs;
+
+void spi_selection_deselect_selected_child_decode (DBusMessage *message, SpiSelectionDeselectSelectedChildArgs *args);
+
+DBusMessage *spi_selection_deselect_selected_child_reply (DBusMessage *message,
+                                                          dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t child_index;
+} SpiSelectionIsChildSelectedArgs;
+
+void spi_selection_is_child_selected_decode (DBusMessage *message, SpiSelectionIsChildSelectedArgs *args);
+
+DBusMessage *spi_selection_is_child_selected_reply (DBusMessage *message,
+                                                    dbus_bool_t result);
+
+DBusMessage *spi_selection_select_all_reply (DBusMessage *message,
+                                             dbus_bool_t result);
+
+DBusMessage *spi_selection_clear_selection_reply (DBusMessage *message,
+                                                  dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t child_index;
+} SpiSelectionDeselectChildArgs;
+
+void spi_selection_deselect_child_decode (DBusMessage *message, SpiSelectionDeselectChildArgs *args);
+
+DBusMessage *spi_selection_deselect_child_reply (DBusMessage *message,
+                                                 dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+  dbus_int32_t column;
+} SpiTableGetAccessibleAtArgs;
+
+void spi_table_get_accessible_at_decode (DBusMessage *message, SpiTableGetAccessibleAtArgs *args);
+
+typedef struct
+{
+  dbus_int32_t row;
+  dbus_int32_t column;
+} SpiTableGetIndexAtArgs;
+
+void spi_table_get_index_at_decode (DBusMessage *message, SpiTableGetIndexAtArgs *args);
+
+DBusMessage *spi_table_get_index_at_reply (DBusMessage *message,
+                                           dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiTableGetRowAtIndexArgs;
+
+void spi_table_get_row_at_index_decode (DBusMessage *message, SpiTableGetRowAtIndexArgs *args);
+
+DBusMessage *spi_table_get_row_at_index_reply (DBusMessage *message,
+                                               dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiTableGetColumnAtIndexArgs;
+
+void spi_table_get_column_at_index_decode (DBusMessage *message, SpiTableGetColumnAtIndexArgs *args);
+
+DBusMessage *spi_table_get_column_at_index_reply (DBusMessage *message,
+                                                  dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+} SpiTableGetRowDescriptionArgs;
+
+void spi_table_get_row_description_decode (DBusMessage *message, SpiTableGetRowDescriptionArgs *args);
+
+DBusMessage *spi_table_get_row_description_reply (DBusMessage *message,
+                                                  const char *result);
+
+typedef struct
+{
+  dbus_int32_t column;
+} SpiTableGetColumnDescriptionArgs;
+
+void spi_table_get_column_description_decode (DBusMessage *message, SpiTableGetColumnDescriptionArgs *args);
+
+DBusMessage *spi_table_get_column_description_reply (DBusMessage *message,
+                                                     const char *result);
+
+typedef struct
+{
+  dbus_int32_t row;
+  dbus_int32_t column;
+} SpiTableGetRowExtentAtArgs;
+
+void spi_table_get_row_extent_at_decode (DBusMessage *message, SpiTableGetRowExtentAtArgs *args);
+
+DBusMessage *spi_table_get_row_extent_at_reply (DBusMessage *message,
+                                                dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+  dbus_int32_t column;
+} SpiTableGetColumnExtentAtArgs;
+
+void spi_table_get_column_extent_at_decode (DBusMessage *message, SpiTableGetColumnExtentAtArgs *args);
+
+DBusMessage *spi_table_get_column_extent_at_reply (DBusMessage *message,
+                                                   dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+} SpiTableGetRowHeaderArgs;
+
+void spi_table_get_row_header_decode (DBusMessage *message, SpiTableGetRowHeaderArgs *args);
+
+typedef struct
+{
+  dbus_int32_t column;
+} SpiTableGetColumnHeaderArgs;
+
+void spi_table_get_column_header_decode (DBusMessage *message, SpiTableGetColumnHeaderArgs *args);
+
+typedef struct
+{
+  dbus_int32_t row;
+} SpiTableIsRowSelectedArgs;
+
+void spi_table_is_row_selected_decode (DBusMessage *message, SpiTableIsRowSelectedArgs *args);
+
+DBusMessage *spi_table_is_row_selected_reply (DBusMessage *message,
+                                              dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t column;
+} SpiTableIsColumnSelectedArgs;
+
+void spi_table_is_column_selected_decode (DBusMessage *message, SpiTableIsColumnSelectedArgs *args);
+
+DBusMessage *spi_table_is_column_selected_reply (DBusMessage *message,
+                                                 dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+  dbus_int32_t column;
+} SpiTableIsSelectedArgs;
+
+void spi_table_is_selected_decode (DBusMessage *message, SpiTableIsSelectedArgs *args);
+
+DBusMessage *spi_table_is_selected_reply (DBusMessage *message,
+                                          dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+} SpiTableAddRowSelectionArgs;
+
+void spi_table_add_row_selection_decode (DBusMessage *message, SpiTableAddRowSelectionArgs *args);
+
+DBusMessage *spi_table_add_row_selection_reply (DBusMessage *message,
+                                                dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t column;
+} SpiTableAddColumnSelectionArgs;
+
+void spi_table_add_column_selection_decode (DBusMessage *message, SpiTableAddColumnSelectionArgs *args);
+
+DBusMessage *spi_table_add_column_selection_reply (DBusMessage *message,
+                                                   dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t row;
+} SpiTableRemoveRowSelectionArgs;
+
+void spi_table_remove_row_selection_decode (DBusMessage *message, SpiTableRemoveRowSelectionArgs *args);
+
+DBusMessage *spi_table_remove_row_selection_reply (DBusMessage *message,
+                                                   dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t column;
+} SpiTableRemoveColumnSelectionArgs;
+
+void spi_table_remove_column_selection_decode (DBusMessage *message, SpiTableRemoveColumnSelectionArgs *args);
+
+DBusMessage *spi_table_remove_column_selection_reply (DBusMessage *message,
+                                                      dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t index;
+} SpiTableGetRowColumnExtentsAtIndexArgs;
+
+void spi_table_get_row_column_extents_at_index_decode (DBusMessage *message, SpiTableGetRowColumnExtentsAtIndexArgs *args);
+
+DBusMessage *spi_table_get_row_column_extents_at_index_reply (DBusMessage *message,
+                                                              dbus_bool_t result,
+                                                              dbus_int32_t row,
+                                                              dbus_int32_t col,
+                                                              dbus_int32_t row_extents,
+                                                              dbus_int32_t col_extents,
+                                                              dbus_bool_t is_selected);
+
+DBusMessage *spi_table_cell_get_row_column_span_reply (DBusMessage *message,
+                                                       dbus_bool_t result,
+                                                       dbus_int32_t row,
+                                                       dbus_int32_t col,
+                                                       dbus_int32_t row_extents,
+                                                       dbus_int32_t col_extents);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  dbus_uint32_t granularity;
+} SpiTextGetStringAtOffsetArgs;
+
+void spi_text_get_string_at_offset_decode (DBusMessage *message, SpiTextGetStringAtOffsetArgs *args);
+
+DBusMessage *spi_text_get_string_at_offset_reply (DBusMessage *message,
+                                                  const char *result,
+                                                  dbus_int32_t start_offset,
+                                                  dbus_int32_t end_offset);
+
+typedef struct
+{
+  dbus_int32_t start_offset;
+  dbus_int32_t end_offset;
+} SpiTextGetTextArgs;
+
+void spi_text_get_text_decode (DBusMessage *message, SpiTextGetTextArgs *args);
+
+DBusMessage *spi_text_get_text_reply (DBusMessage *message,
+                                      const char *result);
+
+typedef struct
+{
+  dbus_int32_t offset;
+} SpiTextSetCaretOffsetArgs;
+
+void spi_text_set_caret_offset_decode (DBusMessage *message, SpiTextSetCaretOffsetArgs *args);
+
+DBusMessage *spi_text_set_caret_offset_reply (DBusMessage *message,
+                                              dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  dbus_uint32_t type;
+} SpiTextGetTextBeforeOffsetArgs;
+
+void spi_text_get_text_before_offset_decode (DBusMessage *message, SpiTextGetTextBeforeOffsetArgs *args);
+
+DBusMessage *spi_text_get_text_before_offset_reply (DBusMessage *message,
+                                                    const char *result,
+                                                    dbus_int32_t start_offset,
+                                                    dbus_int32_t end_offset);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  dbus_uint32_t type;
+} SpiTextGetTextAtOffsetArgs;
+
+void spi_text_get_text_at_offset_decode (DBusMessage *message, SpiTextGetTextAtOffsetArgs *args);
+
+DBusMessage *spi_text_get_text_at_offset_reply (DBusMessage *message,
+                                                const char *result,
+                                                dbus_int32_t start_offset,
+                                                dbus_int32_t end_offset);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  dbus_uint32_t type;
+} SpiTextGetTextAfterOffsetArgs;
+
+void spi_text_get_text_after_offset_decode (DBusMessage *message, SpiTextGetTextAfterOffsetArgs *args);
+
+DBusMessage *spi_text_get_text_after_offset_reply (DBusMessage *message,
+                                                   const char *result,
+                                                   dbus_int32_t start_offset,
+                                                   dbus_int32_t end_offset);
+
+typedef struct
+{
+  dbus_int32_t offset;
+} SpiTextGetCharacterAtOffsetArgs;
+
+void spi_text_get_character_at_offset_decode (DBusMessage *message, SpiTextGetCharacterAtOffsetArgs *args);
+
+DBusMessage *spi_text_get_character_at_offset_reply (DBusMessage *message,
+                                                     dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  const char *attribute_name;
+} SpiTextGetAttributeValueArgs;
+
+void spi_text_get_attribute_value_decode (DBusMessage *message, SpiTextGetAttributeValueArgs *args);
+
+DBusMessage *spi_text_get_attribute_value_reply (DBusMessage *message,
+                                                 const char *result,
+                                                 dbus_int32_t start_offset,
+                                                 dbus_int32_t end_offset,
+                                                 dbus_bool_t defined);
+
+typedef struct
+{
+  dbus_int32_t offset;
+} SpiTextGetAttributesArgs;
+
+void spi_text_get_attributes_decode (DBusMessage *message, SpiTextGetAttributesArgs *args);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  dbus_uint32_t coord_type;
+} SpiTextGetCharacterExtentsArgs;
+
+void spi_text_get_character_extents_decode (DBusMessage *message, SpiTextGetCharacterExtentsArgs *args);
+
+DBusMessage *spi_text_get_character_extents_reply (DBusMessage *message,
+                                                   dbus_int32_t x,
+                                                   dbus_int32_t y,
+                                                   dbus_int32_t width,
+                                                   dbus_int32_t height);
+
+typedef struct
+{
+  dbus_int32_t x;
+  dbus_int32_t y;
+  dbus_uint32_t coord_type;
+} SpiTextGetOffsetAtPointArgs;
+
+void spi_text_get_offset_at_point_decode (DBusMessage *message, SpiTextGetOffsetAtPointArgs *args);
+
+DBusMessage *spi_text_get_offset_at_point_reply (DBusMessage *message,
+                                                 dbus_int32_t result);
+
+DBusMessage *spi_text_get_n_selections_reply (DBusMessage *message,
+                                              dbus_int32_t result);
+
+typedef struct
+{
+  dbus_int32_t selection_num;
+} SpiTextGetSelectionArgs;
+
+void spi_text_get_selection_decode (DBusMessage *message, SpiTextGetSelectionArgs *args);
+
+DBusMessage *spi_text_get_selection_reply (DBusMessage *message,
+                                           dbus_int32_t start_offset,
+                                           dbus_int32_t end_offset);
+
+typedef struct
+{
+  dbus_int32_t start_offset;
+  dbus_int32_t end_offset;
+} SpiTextAddSelectionArgs;
+
+void spi_text_add_selection_decode (DBusMessage *message, SpiTextAddSelectionArgs *args);
+
+DBusMessage *spi_text_add_selection_reply (DBusMessage *message,
+                                           dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t selection_num;
+} SpiTextRemoveSelectionArgs;
+
+void spi_text_remove_selection_decode (DBusMessage *message, SpiTextRemoveSelectionArgs *args);
+
+DBusMessage *spi_text_remove_selection_reply (DBusMessage *message,
+                                              dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t selection_num;
+  dbus_int32_t start_offset;
+  dbus_int32_t end_offset;
+} SpiTextSetSelectionArgs;
+
+void spi_text_set_selection_decode (DBusMessage *message, SpiTextSetSelectionArgs *args);
+
+DBusMessage *spi_text_set_selection_reply (DBusMessage *message,
+                                           dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t start_offset;
+  dbus_int32_t end_offset;
+  dbus_uint32_t coord_type;
+} SpiTextGetRangeExtentsArgs;
+
+void spi_text_get_range_extents_decode (DBusMessage *message, SpiTextGetRangeExtentsArgs *args);
+
+DBusMessage *spi_text_get_range_extents_reply (DBusMessage *message,
+                                               dbus_int32_t x,
+                                               dbus_int32_t y,
+                                               dbus_int32_t width,
+                                               dbus_int32_t height);
+
+typedef struct
+{
+  dbus_int32_t x;
+  dbus_int32_t y;
+  dbus_int32_t width;
+  dbus_int32_t height;
+  dbus_uint32_t coord_type;
+  dbus_uint32_t x_clip_type;
+  dbus_uint32_t y_clip_type;
+} SpiTextGetBoundedRangesArgs;
+
+void spi_text_get_bounded_ranges_decode (DBusMessage *message, SpiTextGetBoundedRangesArgs *args);
+
+typedef struct
+{
+  dbus_int32_t offset;
+  dbus_bool_t include_defaults;
+} SpiTextGetAttributeRunArgs;
+
+void spi_text_get_attribute_run_decode (DBusMessage *message, SpiTextGetAttributeRunArgs *args);
+
+typedef struct
+{
+  const char *new_contents;
+} SpiEditableTextSetTextContentsArgs;
+
+void spi_editable_text_set_text_contents_decode (DBusMessage *message, SpiEditableTextSetTextContentsArgs *args);
+
+DBusMessage *spi_editable_text_set_text_contents_reply (DBusMessage *message,
+                                                        dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t position;
+  const char *text;
+  dbus_int32_t length;
+} SpiEditableTextInsertTextArgs;
+
+void spi_editable_text_insert_text_decode (DBusMessage *message, SpiEditableTextInsertTextArgs *args);
+
+DBusMessage *spi_editable_text_insert_text_reply (DBusMessage *message,
+                                                  dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t start_pos;
+  dbus_int32_t end_pos;
+} SpiEditableTextCopyTextArgs;
+
+void spi_editable_text_copy_text_decode (DBusMessage *message, SpiEditableTextCopyTextArgs *args);
+
+typedef struct
+{
+  dbus_int32_t start_pos;
+  dbus_int32_t end_pos;
+} SpiEditableTextCutTextArgs;
+
+void spi_editable_text_cut_text_decode (DBusMessage *message, SpiEditableTextCutTextArgs *args);
+
+DBusMessage *spi_editable_text_cut_text_reply (DBusMessage *message,
+                                               dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t start_pos;
+  dbus_int32_t end_pos;
+} SpiEditableTextDeleteTextArgs;
+
+void spi_editable_text_delete_text_decode (DBusMessage *message, SpiEditableTextDeleteTextArgs *args);
+
+DBusMessage *spi_editable_text_delete_text_reply (DBusMessage *message,
+                                                  dbus_bool_t result);
+
+typedef struct
+{
+  dbus_int32_t position;
+} SpiEditableTextPasteTextArgs;
+
+void spi_editable_text_paste_text_decode (DBusMessage *message, SpiEditableTextPasteTextArgs *args);
+
+DBusMessage *spi_editable_text_paste_text_reply (DBusMessage *message,
+                                                 dbus_bool_t result);
+
+typedef struct
+{
+  dbus_uint32_t fields;
+} SpiCacheGetItemsCompactArgs;
+
+void spi_cache_get_items_compact_decode (DBusMessage *message, SpiCacheGetItemsCompactArgs *args);
+
+typedef struct
+{
+  const char *root_bus_name;
+  const char *root_path;
+  dbus_uint32_t max_depth;
+} SpiCacheGetItemsForSubtreeArgs;
+
+void spi_cache_get_items_for_subtree_decode (DBusMessage *message, SpiCacheGetItemsForSubtreeArgs *args);
+
+typedef struct
+{
+  dbus_uint32_t cursor;
+  dbus_uint32_t max_items;
+} SpiCacheGetItemsPageArgs;
+
+void spi_cache_get_items_page_decode (DBusMessage *message, SpiCacheGetItemsPageArgs *args);
+
+typedef struct
+{
+  dbus_uint32_t generation;
+} SpiCacheGetItemsSinceArgs;
+
+void spi_cache_get_items_since_decode (DBusMessage *message, SpiCacheGetItemsSinceArgs *args);
+
+#endif /* SPI_METHOD_ARGS_H_ */
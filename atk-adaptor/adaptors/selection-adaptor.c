@@ -29,6 +29,7 @@
 #include "spi-dbus.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_NSelectedChildren (DBusMessageIter * iter, void *user_data)
@@ -232,13 +233,13 @@ impl_DeselectChild (DBusConnection * bus, DBusMessage * message,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetSelectedChild, "GetSelectedChild"},
-  {impl_SelectChild, "SelectChild"},
-  {impl_DeselectSelectedChild, "DeselectSelectedChild"},
-  {impl_IsChildSelected, "IsChildSelected"},
-  {impl_SelectAll, "SelectAll"},
-  {impl_ClearSelection, "ClearSelection"},
-  {impl_DeselectChild, "DeselectChild"},
+  {impl_GetSelectedChild, "GetSelectedChild", SPI_SELECTION_GET_SELECTED_CHILD_SIGNATURE},
+  {impl_SelectChild, "SelectChild", SPI_SELECTION_SELECT_CHILD_SIGNATURE},
+  {impl_DeselectSelectedChild, "DeselectSelectedChild", SPI_SELECTION_DESELECT_SELECTED_CHILD_SIGNATURE},
+  {impl_IsChildSelected, "IsChildSelected", SPI_SELECTION_IS_CHILD_SELECTED_SIGNATURE},
+  {impl_SelectAll, "SelectAll", SPI_SELECTION_SELECT_ALL_SIGNATURE},
+  {impl_ClearSelection, "ClearSelection", SPI_SELECTION_CLEAR_SELECTION_SIGNATURE},
+  {impl_DeselectChild, "DeselectChild", SPI_SELECTION_DESELECT_CHILD_SIGNATURE},
   {NULL, NULL}
 };
 
@@ -29,6 +29,7 @@
 #include "spi-dbus.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_NRows (DBusMessageIter * iter, void *user_data)
@@ -108,7 +109,8 @@ impl_GetAccessibleAt (DBusConnection * bus, DBusMessage * message,
       return droute_invalid_arguments_error (message);
     }
   obj = atk_table_ref_at (table, row, column);
-  reply = spi_object_return_reference (message, obj);
+  reply = spi_object_return_child_reference (message, ATK_OBJECT (table),
+                                             obj);
   if (obj)
     g_object_unref (obj);
 
@@ -632,26 +634,26 @@ impl_GetRowColumnExtentsAtIndex (DBusConnection * bus, DBusMessage * message,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetAccessibleAt, "GetAccessibleAt"},
-  {impl_GetIndexAt, "GetIndexAt"},
-  {impl_GetRowAtIndex, "GetRowAtIndex"},
-  {impl_GetColumnAtIndex, "GetColumnAtIndex"},
-  {impl_GetRowDescription, "GetRowDescription"},
-  {impl_GetColumnDescription, "GetColumnDescription"},
-  {impl_GetRowExtentAt, "GetRowExtentAt"},
-  {impl_GetColumnExtentAt, "GetColumnExtentAt"},
-  {impl_GetRowHeader, "GetRowHeader"},
-  {impl_GetColumnHeader, "GetColumnHeader"},
-  {impl_GetSelectedRows, "GetSelectedRows"},
-  {impl_GetSelectedColumns, "GetSelectedColumns"},
-  {impl_IsRowSelected, "IsRowSelected"},
-  {impl_IsColumnSelected, "IsColumnSelected"},
-  {impl_IsSelected, "IsSelected"},
-  {impl_AddRowSelection, "AddRowSelection"},
-  {impl_AddColumnSelection, "AddColumnSelection"},
-  {impl_RemoveRowSelection, "RemoveRowSelection"},
-  {impl_RemoveColumnSelection, "RemoveColumnSelection"},
-  {impl_GetRowColumnExtentsAtIndex, "GetRowColumnExtentsAtIndex"},
+  {impl_GetAccessibleAt, "GetAccessibleAt", SPI_TABLE_GET_ACCESSIBLE_AT_SIGNATURE},
+  {impl_GetIndexAt, "GetIndexAt", SPI_TABLE_GET_INDEX_AT_SIGNATURE},
+  {impl_GetRowAtIndex, "GetRowAtIndex", SPI_TABLE_GET_ROW_AT_INDEX_SIGNATURE},
+  {impl_GetColumnAtIndex, "GetColumnAtIndex", SPI_TABLE_GET_COLUMN_AT_INDEX_SIGNATURE},
+  {impl_GetRowDescription, "GetRowDescription", SPI_TABLE_GET_ROW_DESCRIPTION_SIGNATURE},
+  {impl_GetColumnDescription, "GetColumnDescription", SPI_TABLE_GET_COLUMN_DESCRIPTION_SIGNATURE},
+  {impl_GetRowExtentAt, "GetRowExtentAt", SPI_TABLE_GET_ROW_EXTENT_AT_SIGNATURE},
+  {impl_GetColumnExtentAt, "GetColumnExtentAt", SPI_TABLE_GET_COLUMN_EXTENT_AT_SIGNATURE},
+  {impl_GetRowHeader, "GetRowHeader", SPI_TABLE_GET_ROW_HEADER_SIGNATURE},
+  {impl_GetColumnHeader, "GetColumnHeader", SPI_TABLE_GET_COLUMN_HEADER_SIGNATURE},
+  {impl_GetSelectedRows, "GetSelectedRows", SPI_TABLE_GET_SELECTED_ROWS_SIGNATURE},
+  {impl_GetSelectedColumns, "GetSelectedColumns", SPI_TABLE_GET_SELECTED_COLUMNS_SIGNATURE},
+  {impl_IsRowSelected, "IsRowSelected", SPI_TABLE_IS_ROW_SELECTED_SIGNATURE},
+  {impl_IsColumnSelected, "IsColumnSelected", SPI_TABLE_IS_COLUMN_SELECTED_SIGNATURE},
+  {impl_IsSelected, "IsSelected", SPI_TABLE_IS_SELECTED_SIGNATURE},
+  {impl_AddRowSelection, "AddRowSelection", SPI_TABLE_ADD_ROW_SELECTION_SIGNATURE},
+  {impl_AddColumnSelection, "AddColumnSelection", SPI_TABLE_ADD_COLUMN_SELECTION_SIGNATURE},
+  {impl_RemoveRowSelection, "RemoveRowSelection", SPI_TABLE_REMOVE_ROW_SELECTION_SIGNATURE},
+  {impl_RemoveColumnSelection, "RemoveColumnSelection", SPI_TABLE_REMOVE_COLUMN_SELECTION_SIGNATURE},
+  {impl_GetRowColumnExtentsAtIndex, "GetRowColumnExtentsAtIndex", SPI_TABLE_GET_ROW_COLUMN_EXTENTS_AT_INDEX_SIGNATURE},
   {NULL, NULL}
 };
 
@@ -28,6 +28,7 @@
 #include "spi-dbus.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_ColumnSpan (DBusMessageIter * iter, void *user_data)
@@ -169,7 +170,7 @@ impl_GetRowColumnSpan (DBusConnection * bus, DBusMessage * message,
 static DRouteMethod methods[] = {
   {impl_GetRowHeaderCells, "GetRowHeaderCells"},
   {impl_GetColumnHeaderCells, "GetColumnHeaderCells"},
-  {impl_GetRowColumnSpan, "GetRowColumnSpan"},
+  {impl_GetRowColumnSpan, "GetRowColumnSpan", SPI_TABLE_CELL_GET_ROW_COLUMN_SPAN_SIGNATURE},
   {NULL, NULL}
 };
 
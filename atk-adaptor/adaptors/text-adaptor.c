@@ -31,6 +31,7 @@
 #include "spi-dbus.h"
 #include "object.h"
 #include "introspection.h"
+#include "method-args.h"
 
 static dbus_bool_t
 impl_get_CharacterCount (DBusMessageIter * iter, void *user_data)
@@ -66,26 +67,16 @@ static DBusMessage *
 impl_GetText (DBusConnection * bus, DBusMessage * message, void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t startOffset, endOffset;
+  SpiTextGetTextArgs args;
   gchar *txt;
   DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &startOffset, DBUS_TYPE_INT32,
-       &endOffset, DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
-  txt = atk_text_get_text (text, startOffset, endOffset);
+  spi_text_get_text_decode (message, &args);
+  txt = atk_text_get_text (text, args.start_offset, args.end_offset);
   txt = validate_allocated_string (txt);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_STRING, &txt,
-                                DBUS_TYPE_INVALID);
-    }
+  reply = spi_text_get_text_reply (message, txt);
   g_free (txt);
   return reply;
 }
@@ -95,25 +86,14 @@ impl_SetCaretOffset (DBusConnection * bus, DBusMessage * message,
                      void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t offset;
+  SpiTextSetCaretOffsetArgs args;
   dbus_bool_t rv;
-  DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &offset, DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
-  rv = atk_text_set_caret_offset (text, offset);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_BOOLEAN, &rv,
-                                DBUS_TYPE_INVALID);
-    }
-  return reply;
+  spi_text_set_caret_offset_decode (message, &args);
+  rv = atk_text_set_caret_offset (text, args.offset);
+  return spi_text_set_caret_offset_reply (message, rv);
 }
 
 static DBusMessage *
@@ -121,35 +101,20 @@ impl_GetTextBeforeOffset (DBusConnection * bus, DBusMessage * message,
                           void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t offset;
-  dbus_uint32_t type;
+  SpiTextGetTextBeforeOffsetArgs args;
   gchar *txt;
-  dbus_int32_t startOffset, endOffset;
   gint intstart_offset = 0, intend_offset = 0;
   DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &offset, DBUS_TYPE_UINT32, &type,
-       DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
+  spi_text_get_text_before_offset_decode (message, &args);
   txt =
-    atk_text_get_text_before_offset (text, offset, (AtkTextBoundary) type,
+    atk_text_get_text_before_offset (text, args.offset, (AtkTextBoundary) args.type,
                                      &intstart_offset, &intend_offset);
-  startOffset = intstart_offset;
-  endOffset = intend_offset;
   txt = validate_allocated_string (txt);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_STRING, &txt,
-                                DBUS_TYPE_INT32, &startOffset,
-                                DBUS_TYPE_INT32, &endOffset,
-                                DBUS_TYPE_INVALID);
-    }
+  reply = spi_text_get_text_before_offset_reply (message, txt,
+                                                 intstart_offset, intend_offset);
   g_free (txt);
   return reply;
 }
@@ -159,34 +124,20 @@ impl_GetTextAtOffset (DBusConnection * bus, DBusMessage * message,
                       void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t offset, type;
+  SpiTextGetTextAtOffsetArgs args;
   gchar *txt;
-  dbus_int32_t startOffset, endOffset;
   gint intstart_offset = 0, intend_offset = 0;
   DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &offset, DBUS_TYPE_UINT32, &type,
-       DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
+  spi_text_get_text_at_offset_decode (message, &args);
   txt =
-    atk_text_get_text_at_offset (text, offset, (AtkTextBoundary) type,
+    atk_text_get_text_at_offset (text, args.offset, (AtkTextBoundary) args.type,
                                  &intstart_offset, &intend_offset);
-  startOffset = intstart_offset;
-  endOffset = intend_offset;
   txt = validate_allocated_string (txt);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_STRING, &txt,
-                                DBUS_TYPE_INT32, &startOffset,
-                                DBUS_TYPE_INT32, &endOffset,
-                                DBUS_TYPE_INVALID);
-    }
+  reply = spi_text_get_text_at_offset_reply (message, txt,
+                                             intstart_offset, intend_offset);
   g_free (txt);
   return reply;
 }
@@ -196,35 +147,20 @@ impl_GetTextAfterOffset (DBusConnection * bus, DBusMessage * message,
                          void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t offset;
-  dbus_uint32_t type;
+  SpiTextGetTextAfterOffsetArgs args;
   gchar *txt;
-  dbus_int32_t startOffset, endOffset;
   gint intstart_offset = 0, intend_offset = 0;
   DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &offset, DBUS_TYPE_UINT32, &type,
-       DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
+  spi_text_get_text_after_offset_decode (message, &args);
   txt =
-    atk_text_get_text_after_offset (text, offset, (AtkTextBoundary) type,
+    atk_text_get_text_after_offset (text, args.offset, (AtkTextBoundary) args.type,
                                     &intstart_offset, &intend_offset);
-  startOffset = intstart_offset;
-  endOffset = intend_offset;
   txt = validate_allocated_string (txt);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_STRING, &txt,
-                                DBUS_TYPE_INT32, &startOffset,
-                                DBUS_TYPE_INT32, &endOffset,
-                                DBUS_TYPE_INVALID);
-    }
+  reply = spi_text_get_text_after_offset_reply (message, txt,
+                                                intstart_offset, intend_offset);
   g_free (txt);
   return reply;
 }
@@ -234,25 +170,14 @@ impl_GetCharacterAtOffset (DBusConnection * bus, DBusMessage * message,
                            void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t offset;
+  SpiTextGetCharacterAtOffsetArgs args;
   dbus_int32_t ch;
-  DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &offset, DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
-  ch = atk_text_get_character_at_offset (text, offset);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_INT32, &ch,
-                                DBUS_TYPE_INVALID);
-    }
-  return reply;
+  spi_text_get_character_at_offset_decode (message, &args);
+  ch = atk_text_get_character_at_offset (text, args.offset);
+  return spi_text_get_character_at_offset_reply (message, ch);
 }
 
 static gchar *
@@ -305,24 +230,18 @@ impl_GetStringAtOffset (DBusConnection * bus, DBusMessage * message,
                         void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t offset;
-  dbus_uint32_t granularity;
+  SpiTextGetStringAtOffsetArgs args;
   gchar *txt = 0;
-  dbus_int32_t startOffset, endOffset;
   gint intstart_offset = 0, intend_offset = 0;
   DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &offset, DBUS_TYPE_UINT32, &granularity,
-       DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
+  spi_text_get_string_at_offset_decode (message, &args);
 
   txt =
-    atk_text_get_string_at_offset (text, offset, (AtkTextGranularity) granularity,
+    atk_text_get_string_at_offset (text, args.offset,
+                                   (AtkTextGranularity) args.granularity,
                                    &intstart_offset, &intend_offset);
 
   /* Accessibility layers implementing an older version of ATK (even if
@@ -330,21 +249,13 @@ impl_GetStringAtOffset (DBusConnection * bus, DBusMessage * message,
    * not to provide an implementation for get_string_at_offset(), so we
    * try with the legacy implementation if that's the case. */
   if (!txt)
-    txt = get_text_for_legacy_implementations(text, offset,
-                                              (AtkTextGranularity) granularity,
+    txt = get_text_for_legacy_implementations(text, args.offset,
+                                              (AtkTextGranularity) args.granularity,
                                               &intstart_offset, &intend_offset);
 
-  startOffset = intstart_offset;
-  endOffset = intend_offset;
   txt = validate_allocated_string (txt);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_STRING, &txt,
-                                DBUS_TYPE_INT32, &startOffset,
-                                DBUS_TYPE_INT32, &endOffset,
-                                DBUS_TYPE_INVALID);
-    }
+  reply = spi_text_get_string_at_offset_reply (message, txt, intstart_offset,
+                                               intend_offset);
   g_free (txt);
   return reply;
 }
@@ -506,27 +417,14 @@ impl_GetOffsetAtPoint (DBusConnection * bus, DBusMessage * message,
                        void *user_data)
 {
   AtkText *text = (AtkText *) user_data;
-  dbus_int32_t x, y;
-  dbus_uint32_t coordType;
+  SpiTextGetOffsetAtPointArgs args;
   dbus_int32_t rv;
-  DBusMessage *reply;
 
   g_return_val_if_fail (ATK_IS_TEXT (user_data),
                         droute_not_yet_handled_error (message));
-  if (!dbus_message_get_args
-      (message, NULL, DBUS_TYPE_INT32, &x, DBUS_TYPE_INT32, &y,
-       DBUS_TYPE_UINT32, &coordType, DBUS_TYPE_INVALID))
-    {
-      return droute_invalid_arguments_error (message);
-    }
-  rv = atk_text_get_offset_at_point (text, x, y, coordType);
-  reply = dbus_message_new_method_return (message);
-  if (reply)
-    {
-      dbus_message_append_args (reply, DBUS_TYPE_INT32, &rv,
-                                DBUS_TYPE_INVALID);
-    }
-  return reply;
+  spi_text_get_offset_at_point_decode (message, &args);
+  rv = atk_text_get_offset_at_point (text, args.x, args.y, args.coord_type);
+  return spi_text_get_offset_at_point_reply (message, rv);
 }
 
 static DBusMessage *
@@ -854,27 +752,27 @@ impl_GetDefaultAttributeSet (DBusConnection * bus, DBusMessage * message,
 }
 
 static DRouteMethod methods[] = {
-  {impl_GetText, "GetText"},
-  {impl_SetCaretOffset, "SetCaretOffset"},
-  {impl_GetTextBeforeOffset, "GetTextBeforeOffset"},
-  {impl_GetTextAtOffset, "GetTextAtOffset"},
-  {impl_GetTextAfterOffset, "GetTextAfterOffset"},
-  {impl_GetStringAtOffset, "GetStringAtOffset"},
-  {impl_GetCharacterAtOffset, "GetCharacterAtOffset"},
-  {impl_GetAttributeValue, "GetAttributeValue"},
-  {impl_GetAttributes, "GetAttributes"},
-  {impl_GetDefaultAttributes, "GetDefaultAttributes"},
-  {impl_GetCharacterExtents, "GetCharacterExtents"},
-  {impl_GetOffsetAtPoint, "GetOffsetAtPoint"},
-  {impl_GetNSelections, "GetNSelections"},
-  {impl_GetSelection, "GetSelection"},
-  {impl_AddSelection, "AddSelection"},
-  {impl_RemoveSelection, "RemoveSelection"},
-  {impl_SetSelection, "SetSelection"},
-  {impl_GetRangeExtents, "GetRangeExtents"},
-  {impl_GetBoundedRanges, "GetBoundedRanges"},
-  {impl_GetAttributeRun, "GetAttributeRun"},
-  {impl_GetDefaultAttributeSet, "GetDefaultAttributeSet"},
+  {impl_GetText, "GetText", SPI_TEXT_GET_TEXT_SIGNATURE},
+  {impl_SetCaretOffset, "SetCaretOffset", SPI_TEXT_SET_CARET_OFFSET_SIGNATURE},
+  {impl_GetTextBeforeOffset, "GetTextBeforeOffset", SPI_TEXT_GET_TEXT_BEFORE_OFFSET_SIGNATURE},
+  {impl_GetTextAtOffset, "GetTextAtOffset", SPI_TEXT_GET_TEXT_AT_OFFSET_SIGNATURE},
+  {impl_GetTextAfterOffset, "GetTextAfterOffset", SPI_TEXT_GET_TEXT_AFTER_OFFSET_SIGNATURE},
+  {impl_GetStringAtOffset, "GetStringAtOffset", SPI_TEXT_GET_STRING_AT_OFFSET_SIGNATURE},
+  {impl_GetCharacterAtOffset, "GetCharacterAtOffset", SPI_TEXT_GET_CHARACTER_AT_OFFSET_SIGNATURE},
+  {impl_GetAttributeValue, "GetAttributeValue", SPI_TEXT_GET_ATTRIBUTE_VALUE_SIGNATURE},
+  {impl_GetAttributes, "GetAttributes", SPI_TEXT_GET_ATTRIBUTES_SIGNATURE},
+  {impl_GetDefaultAttributes, "GetDefaultAttributes", SPI_TEXT_GET_DEFAULT_ATTRIBUTES_SIGNATURE},
+  {impl_GetCharacterExtents, "GetCharacterExtents", SPI_TEXT_GET_CHARACTER_EXTENTS_SIGNATURE},
+  {impl_GetOffsetAtPoint, "GetOffsetAtPoint", SPI_TEXT_GET_OFFSET_AT_POINT_SIGNATURE},
+  {impl_GetNSelections, "GetNSelections", SPI_TEXT_GET_N_SELECTIONS_SIGNATURE},
+  {impl_GetSelection, "GetSelection", SPI_TEXT_GET_SELECTION_SIGNATURE},
+  {impl_AddSelection, "AddSelection", SPI_TEXT_ADD_SELECTION_SIGNATURE},
+  {impl_RemoveSelection, "RemoveSelection", SPI_TEXT_REMOVE_SELECTION_SIGNATURE},
+  {impl_SetSelection, "SetSelection", SPI_TEXT_SET_SELECTION_SIGNATURE},
+  {impl_GetRangeExtents, "GetRangeExtents", SPI_TEXT_GET_RANGE_EXTENTS_SIGNATURE},
+  {impl_GetBoundedRanges, "GetBoundedRanges", SPI_TEXT_GET_BOUNDED_RANGES_SIGNATURE},
+  {impl_GetAttributeRun, "GetAttributeRun", SPI_TEXT_GET_ATTRIBUTE_RUN_SIGNATURE},
+  {impl_GetDefaultAttributeSet, "GetDefaultAttributeSet", SPI_TEXT_GET_DEFAULT_ATTRIBUTE_SET_SIGNATURE},
   {NULL, NULL}
 };
 
@@ -30,8 +30,10 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <signal.h>
 #include<sys/stat.h>
 #include <atk/atk.h>
+#include <glib-unix.h>
 
 #include <droute/droute.h>
 #include <atspi/atspi.h>
@@ -46,6 +48,7 @@
 #include "accessible-register.h"
 #include "accessible-leasing.h"
 #include "accessible-cache.h"
+#include "accessible-prefetch.h"
 
 #include "spi-dbus.h"
 
@@ -58,8 +61,108 @@ SpiBridge *spi_global_app_data = NULL;
 
 static gboolean inited = FALSE;
 
+/* Holds the real notify function of a pending call in I/O thread mode */
+static dbus_int32_t notify_slot = -1;
+static gboolean notify_slot_allocated = FALSE;
+
 /*---------------------------------------------------------------------------*/
 
+/*
+ * What each client opted in to, kept up to date as events are registered
+ * and deregistered so that signals can be sent without looking through
+ * the events. Clients that opted in to nothing are not in the table.
+ */
+static GHashTable *client_opt_ins = NULL;
+static guint n_batching_clients = 0;
+static guint n_compact_clients = 0;
+
+static guint
+event_opt_in (gchar **data)
+{
+  if (!data[0] || !data[1] || g_ascii_strcasecmp (data[0], "cache"))
+    return 0;
+  if (!g_ascii_strcasecmp (data[1], "batched"))
+    return SPI_CLIENT_BATCHED;
+  if (!g_ascii_strcasecmp (data[1], "compact"))
+    return SPI_CLIENT_COMPACT;
+  if (!g_ascii_strcasecmp (data[1], "prefetch"))
+    return SPI_CLIENT_PREFETCH;
+  return 0;
+}
+
+static guint
+get_client_opt_ins (const char *bus_name)
+{
+  if (!client_opt_ins)
+    return 0;
+  return GPOINTER_TO_UINT (g_hash_table_lookup (client_opt_ins, bus_name));
+}
+
+static void
+set_client_opt_ins (const char *bus_name, guint opt_ins)
+{
+  guint old = get_client_opt_ins (bus_name);
+
+  if (old == opt_ins)
+    return;
+
+  if ((old ^ opt_ins) & SPI_CLIENT_BATCHED)
+    {
+      if (opt_ins & SPI_CLIENT_BATCHED)
+        n_batching_clients++;
+      else
+        n_batching_clients--;
+    }
+  if ((old ^ opt_ins) & SPI_CLIENT_COMPACT)
+    {
+      if (opt_ins & SPI_CLIENT_COMPACT)
+        n_compact_clients++;
+      else
+        n_compact_clients--;
+    }
+  if ((old & SPI_CLIENT_PREFETCH) && !(opt_ins & SPI_CLIENT_PREFETCH))
+    spi_prefetch_forget_client (bus_name);
+
+  if (!client_opt_ins)
+    client_opt_ins = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                            g_free, NULL);
+  if (opt_ins)
+    g_hash_table_insert (client_opt_ins, g_strdup (bus_name),
+                         GUINT_TO_POINTER (opt_ins));
+  else
+    g_hash_table_remove (client_opt_ins, bus_name);
+}
+
+static void
+add_client_opt_ins (const char *bus_name, guint opt_ins)
+{
+  if (opt_ins)
+    set_client_opt_ins (bus_name, get_client_opt_ins (bus_name) | opt_ins);
+}
+
+/*
+ * Works out again what bus_name opted in to, after some of its events
+ * were deregistered.
+ */
+static void
+update_client_opt_ins (const char *bus_name)
+{
+  GList *l;
+  guint opt_ins = 0;
+
+  if (!get_client_opt_ins (bus_name))
+    return;
+
+  for (l = spi_global_app_data->events; l; l = l->next)
+    {
+      event_data *evdata = l->data;
+
+      if (!g_strcmp0 (evdata->bus_name, bus_name))
+        opt_ins |= event_opt_in (evdata->data);
+    }
+  set_client_opt_ins (bus_name, opt_ins);
+}
+
 static event_data *
 add_event (const char *bus_name, const char *event)
 {
@@ -77,6 +180,7 @@ add_event (const char *bus_name, const char *event)
   evdata->bus_name = g_strdup (bus_name);
   evdata->data = data;
   spi_global_app_data->events = g_list_append (spi_global_app_data->events, evdata);
+  add_client_opt_ins (bus_name, event_opt_in (data));
   return evdata;
 }
 
@@ -262,6 +366,120 @@ done:
   tally_event_reply ();
 }
 
+static void
+get_device_events_reply (DBusPendingCall *pending, void *user_data);
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * When the connections are dispatched on the I/O thread, pending call
+ * notifications arrive there too. These replies touch bridge state, so
+ * they are bounced to a main context, holding a ref on the pending call
+ * meanwhile, before being looked at.
+ */
+typedef struct _NotifyTarget
+{
+  DBusPendingCallNotifyFunction func;
+  GMainContext *context;
+  /* Set once the reply has been bounced, which only happens once */
+  gint bounced;
+} NotifyTarget;
+
+typedef struct _NotifyOnMain
+{
+  DBusPendingCallNotifyFunction func;
+  DBusPendingCall *pending;
+  void *user_data;
+} NotifyOnMain;
+
+static void
+notify_target_free (void *data)
+{
+  NotifyTarget *target = data;
+
+  if (target->context)
+    g_main_context_unref (target->context);
+  g_free (target);
+}
+
+static gboolean
+notify_on_main_idle (gpointer data)
+{
+  NotifyOnMain *notify = data;
+
+  notify->func (notify->pending, notify->user_data);
+  dbus_pending_call_unref (notify->pending);
+  g_free (notify);
+  return FALSE;
+}
+
+static void
+notify_on_main (DBusPendingCall *pending, void *user_data)
+{
+  NotifyTarget *target = dbus_pending_call_get_data (pending, notify_slot);
+  NotifyOnMain *notify;
+  GSource *source;
+
+  if (!g_atomic_int_compare_and_exchange (&target->bounced, 0, 1))
+    return;
+
+  notify = g_new (NotifyOnMain, 1);
+  notify->func = target->func;
+  notify->pending = dbus_pending_call_ref (pending);
+  notify->user_data = user_data;
+
+  source = g_idle_source_new ();
+  g_source_set_callback (source, notify_on_main_idle, notify, NULL);
+  g_source_attach (source, target->context);
+  g_source_unref (source);
+}
+
+/*
+ * Sets func to be called with the reply to pending on context, or on
+ * the default main context if context is NULL. free_user_data is called
+ * once pending is finalized, which may be on the I/O thread.
+ */
+void
+spi_pending_call_set_notify (DBusPendingCall *pending,
+                             DBusPendingCallNotifyFunction func,
+                             void *user_data,
+                             DBusFreeFunction free_user_data,
+                             GMainContext *context)
+{
+  NotifyTarget *target;
+
+  if (!spi_global_app_data->io_thread)
+    {
+      dbus_pending_call_set_notify (pending, func, user_data, free_user_data);
+      return;
+    }
+
+  target = g_new (NotifyTarget, 1);
+  target->func = func;
+  target->context = context ? g_main_context_ref (context) : NULL;
+  target->bounced = 0;
+  dbus_pending_call_set_data (pending, notify_slot, target, notify_target_free);
+  dbus_pending_call_set_notify (pending, notify_on_main, user_data,
+                                free_user_data);
+
+  /*
+   * The I/O thread may have completed the call before there was a notify
+   * to call, in which case libdbus will never call it.
+   */
+  if (dbus_pending_call_get_completed (pending))
+    notify_on_main (pending, user_data);
+}
+
+static void
+set_notify_on_main (DBusPendingCall *pending,
+                    DBusPendingCallNotifyFunction func,
+                    void *user_data)
+{
+  spi_pending_call_set_notify (pending, func, user_data, NULL, NULL);
+}
+
+/*---------------------------------------------------------------------------*/
+
 static void
 get_device_events_reply (DBusPendingCall *pending, void *user_data)
 {
@@ -317,7 +535,7 @@ get_registered_event_listeners (SpiBridge *app)
       spi_global_app_data->events_initialized = TRUE;
       return;
     }
-  dbus_pending_call_set_notify (pending, get_events_reply, NULL, NULL);
+  set_notify_on_main (pending, get_events_reply, NULL);
 
   message = dbus_message_new_method_call (SPI_DBUS_NAME_REGISTRY,
                                          ATSPI_DBUS_PATH_DEC,
@@ -333,7 +551,7 @@ get_registered_event_listeners (SpiBridge *app)
       spi_global_app_data->events_initialized = TRUE;
       return;
     }
-  dbus_pending_call_set_notify (pending, get_device_events_reply, NULL, NULL);
+  set_notify_on_main (pending, get_device_events_reply, NULL);
 
   message = dbus_message_new_method_call (SPI_DBUS_NAME_REGISTRY,
                                          ATSPI_DBUS_PATH_DEC,
@@ -349,7 +567,7 @@ get_registered_event_listeners (SpiBridge *app)
       spi_global_app_data->events_initialized = TRUE;
       return;
     }
-  dbus_pending_call_set_notify (pending, get_device_events_reply, NULL, NULL);
+  set_notify_on_main (pending, get_device_events_reply, NULL);
 }
 
 static void
@@ -435,7 +653,7 @@ register_application (SpiBridge * app)
         return FALSE;
     }
 
-    dbus_pending_call_set_notify (pending, register_reply, app, NULL);
+    set_notify_on_main (pending, register_reply, app);
 
   if (message)
     dbus_message_unref (message);
@@ -496,14 +714,10 @@ static AtkSocketClass *socket_class;
 static gchar *
 get_plug_id (AtkPlug * plug)
 {
-  const char *uname = dbus_bus_get_unique_name (spi_global_app_data->bus);
-  gchar *path;
-  GString *str = g_string_new (NULL);
+  const char *path;
 
-  path = spi_register_object_to_path (spi_global_register, G_OBJECT (plug));
-  g_string_printf (str, "%s:%s", uname, path);
-  g_free (path);
-  return g_string_free (str, FALSE);
+  path = spi_register_object_get_path (spi_global_register, G_OBJECT (plug));
+  return g_strdup_printf ("%s:%s", spi_global_app_data->bus_name, path);
 }
 
 AtkStateSet *
@@ -654,16 +868,28 @@ user_check (DBusConnection *bus, unsigned long uid, void *data)
   return FALSE;
 }
 
+static gboolean
+add_direct_connection (gpointer data)
+{
+  DBusConnection *con = data;
+
+  spi_global_app_data->direct_connections = g_list_append (spi_global_app_data->direct_connections, con);
+  return FALSE;
+}
+
 static void
 new_connection_cb (DBusServer *server, DBusConnection *con, void *data)
 {
   dbus_connection_set_unix_user_function (con, user_check, NULL, NULL);
   dbus_connection_ref(con);
-  atspi_dbus_connection_setup_with_g_main(con, NULL);
+  atspi_dbus_connection_setup_with_g_main(con, spi_global_app_data->io_context);
   droute_intercept_dbus (con);
   droute_context_register (spi_global_app_data->droute, con);
 
-  spi_global_app_data->direct_connections = g_list_append (spi_global_app_data->direct_connections, con);
+  if (spi_global_app_data->io_thread)
+    g_main_context_invoke (NULL, add_direct_connection, con);
+  else
+    add_direct_connection (con);
 }
 
 
@@ -678,13 +904,65 @@ static GOptionEntry atspi_option_entries[] = {
   {NULL}
 };
 
+/*
+ * The children of the accessible path are listed as the root and the
+ * cached toplevels, the root's children, rather than every registered
+ * object. The listing is built once and thrown away when a toplevel
+ * enters or leaves the cache.
+ */
+static gchar *introspect_children = NULL;
+
+static void
+invalidate_introspect_children (void)
+{
+  g_free (introspect_children);
+  introspect_children = NULL;
+}
+
+static void
+toplevel_cache_changed (SpiCache *cache, GObject *gobj, gpointer data)
+{
+  const SpiCacheItem *item = spi_cache_peek_item (cache, gobj);
+  gboolean toplevel;
+
+  /* A removed object's parent may be gone; its item still knows it */
+  if (item && !(item->stale & SPI_CACHE_FIELD_PARENT))
+    toplevel = item->has_parent && item->parent == 0;
+  else
+    toplevel = atk_object_get_parent (ATK_OBJECT (gobj)) ==
+               spi_global_app_data->root;
+  if (toplevel)
+    invalidate_introspect_children ();
+}
+
 static gchar *
 introspect_children_cb (const char *path, void *data)
 {
   if (!strcmp (path, "/org/a11y/atspi/accessible"))
     {
-      return g_strdup ("<node name=\"root\"/>\n");
-      /* TODO: Should we place the whole hierarchy here? */
+      if (!introspect_children)
+        {
+          AtkObject *root = spi_global_app_data->root;
+          GString *str = g_string_new ("<node name=\"root\"/>\n");
+          gint i, count = 0;
+
+          if (spi_global_cache)
+            count = atk_object_get_n_accessible_children (root);
+          for (i = 0; i < count; i++)
+            {
+              AtkObject *child = atk_object_ref_accessible_child (root, i);
+
+              if (!child)
+                continue;
+              if (spi_cache_in (spi_global_cache, G_OBJECT (child)))
+                g_string_append_printf (str, "<node name=\"%" G_GUINT64_FORMAT
+                                        "\"/>\n",
+                                        spi_register_object_to_ref (G_OBJECT (child)));
+              g_object_unref (child);
+            }
+          introspect_children = g_string_free (str, FALSE);
+        }
+      return g_strdup (introspect_children);
     }
   return NULL;
 }
@@ -758,6 +1036,7 @@ remove_events (const char *bus_name, const char *event)
     }
 
   g_strfreev (remove_data);
+  update_client_opt_ins (bus_name);
 }
 
 static void
@@ -793,6 +1072,25 @@ handle_device_listener_registered (DBusConnection *bus, DBusMessage *message,
   spi_atk_add_client (sender);
 }
 
+typedef struct _FilterOnMain
+{
+  DBusConnection *bus;
+  DBusMessage *message;
+  void *user_data;
+} FilterOnMain;
+
+static gboolean
+signal_filter_idle (gpointer data)
+{
+  FilterOnMain *filter = data;
+
+  signal_filter (filter->bus, filter->message, filter->user_data);
+  dbus_message_unref (filter->message);
+  dbus_connection_unref (filter->bus);
+  g_free (filter);
+  return FALSE;
+}
+
 static DBusHandlerResult
 signal_filter (DBusConnection *bus, DBusMessage *message, void *user_data)
 {
@@ -804,6 +1102,21 @@ signal_filter (DBusConnection *bus, DBusMessage *message, void *user_data)
   if (dbus_message_get_type (message) != DBUS_MESSAGE_TYPE_SIGNAL)
     return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 
+  /* Registry and client bookkeeping belongs to the main thread. Signals
+   * are never handled exclusively here, so let other filters see them.
+   */
+  if (spi_global_app_data->io_thread &&
+      g_thread_self () == spi_global_app_data->io_thread)
+    {
+      FilterOnMain *filter = g_new (FilterOnMain, 1);
+
+      filter->bus = dbus_connection_ref (bus);
+      filter->message = dbus_message_ref (message);
+      filter->user_data = user_data;
+      g_idle_add (signal_filter_idle, filter);
+      return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    }
+
   if (!strcmp (interface, ATSPI_DBUS_INTERFACE_REGISTRY))
     {
       result = DBUS_HANDLER_RESULT_HANDLED;
@@ -846,7 +1159,10 @@ signal_filter (DBusConnection *bus, DBusMessage *message, void *user_data)
                 registry_lost = TRUE;
             }
           else if (*old != '\0' && *new == '\0')
+            {
+              droute_cancel_pending_replies (old);
               spi_atk_remove_client (old);
+            }
         }
     }
 
@@ -893,7 +1209,7 @@ spi_atk_create_socket (SpiBridge *app)
     return -1;
   }
 
-  atspi_dbus_server_setup_with_g_main(server, NULL);
+  atspi_dbus_server_setup_with_g_main(server, spi_global_app_data->io_context);
   dbus_server_set_new_connection_function(server, new_connection_cb, NULL, NULL);
 
   spi_global_app_data->server = server;
@@ -929,9 +1245,17 @@ spi_atk_activate ()
   DRoutePath *treepath;
 
   spi_atk_register_event_listeners ();
-  if (!spi_global_cache)
+
+  /* Nothing was listening for changes since the last client left */
+  if (spi_global_cache)
+    spi_cache_invalidate (spi_global_cache);
+  else
     {
       spi_global_cache    = g_object_new (SPI_CACHE_TYPE, NULL);
+      g_signal_connect (spi_global_cache, "object-added",
+                        (GCallback) toplevel_cache_changed, NULL);
+      g_signal_connect (spi_global_cache, "object-removed",
+                        (GCallback) toplevel_cache_changed, NULL);
       treepath = droute_add_one (spi_global_app_data->droute,
                                  "/org/a11y/atspi/cache", spi_global_cache);
 
@@ -946,6 +1270,122 @@ spi_atk_activate ()
     }
 }
 
+/*
+ * Setting ATK_BRIDGE_STATS_FILE turns on droute's per-method statistics.
+ * They are written to that file on SIGUSR2 and when the bridge shuts down,
+ * followed by a second table with the leasing counters.
+ */
+static guint stats_signal_id = 0;
+
+static void
+dump_stats (void)
+{
+  const gchar *filename = g_getenv ("ATK_BRIDGE_STATS_FILE");
+  DRouteStats *stats = droute_context_get_stats (spi_global_app_data->droute);
+  GError *err = NULL;
+  GString *out;
+  gchar *table;
+
+  if (!filename || !stats)
+    return;
+
+  table = droute_stats_format (stats);
+  out = g_string_new (table);
+  g_free (table);
+  if (spi_global_leasing)
+    g_string_append_printf (out,
+                            "# leases_live leases_taken leases_renewed leases_expired\n"
+                            "%u %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT
+                            " %" G_GUINT64_FORMAT "\n",
+                            spi_global_leasing->n_live,
+                            spi_global_leasing->n_taken,
+                            spi_global_leasing->n_renewed,
+                            spi_global_leasing->n_expired);
+
+  if (!g_file_set_contents (filename, out->str, out->len, &err))
+    {
+      g_warning ("atk-bridge: could not write statistics: %s", err->message);
+      g_error_free (err);
+    }
+  g_string_free (out, TRUE);
+}
+
+static gboolean
+dump_stats_cb (gpointer data)
+{
+  dump_stats ();
+  return TRUE;
+}
+
+static void
+init_stats (SpiBridge *app)
+{
+  const gchar *filename = g_getenv ("ATK_BRIDGE_STATS_FILE");
+
+  droute_add_stats (app->droute, "/org/a11y/atspi/stats");
+
+  if (!filename || !filename[0])
+    return;
+
+  droute_context_set_stats_enabled (app->droute, TRUE);
+  stats_signal_id = g_unix_signal_add (SIGUSR2, dump_stats_cb, NULL);
+}
+
+/*
+ * Returns TRUE if ATK_BRIDGE_IO_THREAD asks for D-Bus I/O to be done
+ * on a dedicated thread.
+ */
+static gboolean
+check_io_thread_envvar (void)
+{
+  const gchar *envvar;
+
+  envvar = g_getenv ("ATK_BRIDGE_IO_THREAD");
+
+  return (envvar && atoi (envvar) == 1);
+}
+
+static gpointer
+io_thread_func (gpointer data)
+{
+  SpiBridge *app = data;
+
+  g_main_context_push_thread_default (app->io_context);
+  g_main_loop_run (app->io_loop);
+  g_main_context_pop_thread_default (app->io_context);
+
+  return NULL;
+}
+
+/*
+ * Moves reading, writing and parsing of D-Bus messages onto their own
+ * thread. Method calls are still handed to the main thread, where ATK
+ * may be called, but the connections keep being serviced while the
+ * main thread is busy.
+ */
+static void
+start_io_thread (SpiBridge *app)
+{
+  app->io_context = g_main_context_new ();
+  app->io_loop = g_main_loop_new (app->io_context, FALSE);
+  app->io_thread = g_thread_new ("atk-bridge-io", io_thread_func, app);
+}
+
+static void
+stop_io_thread (SpiBridge *app)
+{
+  if (!app->io_thread)
+    return;
+
+  g_main_loop_quit (app->io_loop);
+  g_thread_join (app->io_thread);
+  app->io_thread = NULL;
+  g_main_loop_unref (app->io_loop);
+  app->io_loop = NULL;
+  g_main_context_unref (app->io_context);
+  app->io_context = NULL;
+}
+
 /*
  * spi_app_init
  *
@@ -999,16 +1439,28 @@ atk_bridge_adaptor_init (gint * argc, gchar ** argv[])
   spi_global_app_data = g_new0 (SpiBridge, 1);
   spi_global_app_data->root = g_object_ref (root);
 
+  /* libdbus must know about threads before the first connection is made */
+  if (check_io_thread_envvar ())
+    {
+      if (!notify_slot_allocated)
+        notify_slot_allocated = dbus_pending_call_allocate_data_slot (&notify_slot);
+      if (notify_slot_allocated && dbus_threads_init_default ())
+        start_io_thread (spi_global_app_data);
+    }
+
   /* Set up D-Bus connection and register bus name */
   dbus_error_init (&error);
   spi_global_app_data->bus = atspi_get_a11y_bus ();
   if (!spi_global_app_data->bus)
     {
+      stop_io_thread (spi_global_app_data);
       g_free (spi_global_app_data);
       spi_global_app_data = NULL;
       inited = FALSE;
       return -1;
     }
+  spi_global_app_data->bus_name =
+      dbus_bus_get_unique_name (spi_global_app_data->bus);
 
   if (atspi_dbus_name != NULL)
     {
@@ -1027,7 +1479,8 @@ atk_bridge_adaptor_init (gint * argc, gchar ** argv[])
 
   spi_global_app_data->main_context = g_main_context_new ();
 
-  atspi_dbus_connection_setup_with_g_main (spi_global_app_data->bus, NULL);
+  atspi_dbus_connection_setup_with_g_main (spi_global_app_data->bus,
+                                           spi_global_app_data->io_context);
 
   /* Hook our plug-and socket functions */
   install_plug_hooks ();
@@ -1071,6 +1524,20 @@ atk_bridge_adaptor_init (gint * argc, gchar ** argv[])
   spi_initialize_text (accpath);
   spi_initialize_value (accpath);
 
+  /* Lets an AT issue many of the above calls in one round-trip */
+  droute_add_batch (spi_global_app_data->droute, "/org/a11y/atspi/batch");
+
+  /* Per-method call counts and latencies, see ATK_BRIDGE_STATS_FILE */
+  init_stats (spi_global_app_data);
+
+  /* Follows how clients read the tree, see accessible-prefetch.c */
+  droute_context_set_call_observer (spi_global_app_data->droute,
+                                    spi_prefetch_observe, NULL);
+
+  if (spi_global_app_data->io_thread)
+    droute_context_set_dispatch_context (spi_global_app_data->droute,
+                                         g_main_context_default ());
+
   droute_context_register (spi_global_app_data->droute,
                            spi_global_app_data->bus);
 
@@ -1110,6 +1577,14 @@ atk_bridge_adaptor_cleanup (void)
   spi_atk_tidy_windows ();
   spi_atk_deregister_event_listeners ();
 
+  dump_stats ();
+  if (stats_signal_id)
+    {
+      g_source_remove (stats_signal_id);
+      stats_signal_id = 0;
+    }
+  spi_prefetch_shutdown ();
+
   deregister_application (spi_global_app_data);
 
   if (spi_global_app_data->bus)
@@ -1119,6 +1594,7 @@ atk_bridge_adaptor_cleanup (void)
       dbus_connection_close (spi_global_app_data->bus);
       dbus_connection_unref (spi_global_app_data->bus);
       spi_global_app_data->bus = NULL;
+      spi_global_app_data->bus_name = NULL;
     }
 
   for (l = spi_global_app_data->direct_connections; l; l = l->next)
@@ -1135,14 +1611,20 @@ atk_bridge_adaptor_cleanup (void)
   g_list_free (spi_global_app_data->direct_connections);
   spi_global_app_data->direct_connections = NULL;
 
+  stop_io_thread (spi_global_app_data);
+
   for (ls = clients; ls; ls = ls->next)
     g_free (ls->data);
   g_slist_free (clients);
   clients = NULL;
+  g_clear_pointer (&client_opt_ins, g_hash_table_destroy);
+  n_batching_clients = 0;
+  n_compact_clients = 0;
 
   g_clear_object (&spi_global_cache);
   g_clear_object (&spi_global_leasing);
   g_clear_object (&spi_global_register);
+  invalidate_introspect_children ();
 
   if (spi_global_app_data->main_context)
     g_main_context_unref (spi_global_app_data->main_context);
@@ -1195,6 +1677,8 @@ spi_atk_remove_client (const char *bus_name)
       gchar *match = g_strdup_printf (name_match_tmpl, l->data);
       dbus_bus_remove_match (spi_global_app_data->bus, match, NULL);
   g_free (match);
+      spi_prefetch_forget_client (l->data);
+      set_client_opt_ins (l->data, 0);
       g_free (l->data);
       clients = g_slist_delete_link (clients, l);
       if (!clients)
@@ -1206,6 +1690,79 @@ spi_atk_remove_client (const char *bus_name)
   }
 }
 
+/*
+ * Clients opt in to the batched AddAccessibles and RemoveAccessibles
+ * cache signals by registering for the "cache:batched" event.
+ *
+ * Returns how many of the known clients have done so, and sets
+ * n_clients to the number of known clients.
+ */
+guint
+spi_atk_count_batching_clients (guint *n_clients)
+{
+  *n_clients = g_slist_length (clients);
+  if (!spi_global_app_data->events_initialized)
+    return 0;
+  return n_batching_clients;
+}
+
+/*
+ * Clients opt in to the compact encoding of cache signals by
+ * registering for the "cache:compact" event. Returns the count as
+ * spi_atk_count_batching_clients does.
+ */
+guint
+spi_atk_count_compact_clients (guint *n_clients)
+{
+  *n_clients = g_slist_length (clients);
+  if (!spi_global_app_data->events_initialized)
+    return 0;
+  return n_compact_clients;
+}
+
+/*
+ * Sends a copy of message to each client that opted in to all of with
+ * and to none of without, rather than broadcasting it to everyone.
+ */
+void
+spi_atk_send_to_clients (DBusMessage *message, guint with, guint without)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+
+  if (!client_opt_ins || !spi_global_app_data->events_initialized)
+    return;
+
+  g_hash_table_iter_init (&iter, client_opt_ins);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      guint opt_ins = GPOINTER_TO_UINT (value);
+      DBusMessage *copy;
+
+      if ((opt_ins & with) != with || (opt_ins & without))
+        continue;
+
+      copy = dbus_message_copy (message);
+      if (!copy)
+        continue;
+      dbus_message_set_destination (copy, key);
+      dbus_connection_send (spi_global_app_data->bus, copy, NULL);
+      dbus_message_unref (copy);
+    }
+}
+
+/*
+ * Clients opt in to Prefetch signals by registering for the
+ * "cache:prefetch" event.
+ */
+gboolean
+spi_atk_client_wants_prefetch (const char *bus_name)
+{
+  if (!spi_global_app_data->events_initialized)
+    return FALSE;
+  return (get_client_opt_ins (bus_name) & SPI_CLIENT_PREFETCH) != 0;
+}
+
 void
 spi_atk_add_interface (DRoutePath *path,
                        const char *name,
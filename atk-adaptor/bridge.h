@@ -56,11 +56,18 @@ struct _SpiBridge
   AtkObject *root;
 
   DBusConnection *bus;
+  /* Unique name of bus, owned by the connection */
+  const gchar *bus_name;
   DRouteContext  *droute;
   GMainContext *main_context;
   DBusServer *server;
   GList *direct_connections;
 
+  /* Only set when D-Bus I/O runs on its own thread */
+  GMainContext *io_context;
+  GMainLoop *io_loop;
+  GThread *io_thread;
+
 /*
   SpiRegister *reg;
   SpiCache    *cache;
@@ -77,8 +84,25 @@ gchar *app_bus_addr;
 
 extern SpiBridge *spi_global_app_data;
 
+/* Cache events clients register for to opt in to extensions */
+typedef enum
+{
+  SPI_CLIENT_BATCHED = 1 << 0,  /* "cache:batched" */
+  SPI_CLIENT_COMPACT = 1 << 1,  /* "cache:compact" */
+  SPI_CLIENT_PREFETCH = 1 << 2  /* "cache:prefetch" */
+} SpiClientOptIn;
+
 void spi_atk_add_client (const char *bus_name);
 void spi_atk_remove_client (const char *bus_name);
+guint spi_atk_count_batching_clients (guint *n_clients);
+guint spi_atk_count_compact_clients (guint *n_clients);
+void spi_atk_send_to_clients (DBusMessage *message, guint with, guint without);
+gboolean spi_atk_client_wants_prefetch (const char *bus_name);
+void spi_pending_call_set_notify (DBusPendingCall *pending,
+                                  DBusPendingCallNotifyFunction func,
+                                  void *user_data,
+                                  DBusFreeFunction free_user_data,
+                                  GMainContext *context);
 
 int spi_atk_create_socket (SpiBridge *app);
 
@@ -0,0 +1,442 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * Copyright 2008 Novell, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Runs the bounded cache, its change log, the register and the sorting
+ * of removed objects against a small tree of fake accessibles, without
+ * a bus. Only the cache, register, leasing and removals are linked in,
+ * so the two object.c helpers they use are provided here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atk/atk.h>
+#include <atspi/atspi.h>
+
+#include "accessible-cache.h"
+#include "accessible-register.h"
+#include "accessible-leasing.h"
+#include "accessible-removals.h"
+#include "bridge.h"
+#include "object.h"
+
+#define N_CHILDREN 3
+
+SpiBridge *spi_global_app_data = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+typedef struct _TestObject TestObject;
+typedef struct _TestObjectClass TestObjectClass;
+
+struct _TestObject
+{
+  AtkObject parent;
+
+  GPtrArray *children;
+  gboolean showing;
+};
+
+struct _TestObjectClass
+{
+  AtkObjectClass parent_class;
+};
+
+GType test_object_get_type (void);
+
+G_DEFINE_TYPE (TestObject, test_object, ATK_TYPE_OBJECT)
+
+#define TEST_OBJECT(o) (G_TYPE_CHECK_INSTANCE_CAST ((o), test_object_get_type (), TestObject))
+
+static gint
+test_object_get_n_children (AtkObject * accessible)
+{
+  return TEST_OBJECT (accessible)->children->len;
+}
+
+static AtkObject *
+test_object_ref_child (AtkObject * accessible, gint i)
+{
+  TestObject *object = TEST_OBJECT (accessible);
+
+  if (i < 0 || i >= object->children->len)
+    return NULL;
+  return g_object_ref (g_ptr_array_index (object->children, i));
+}
+
+static AtkStateSet *
+test_object_ref_state_set (AtkObject * accessible)
+{
+  AtkStateSet *set = atk_state_set_new ();
+
+  if (TEST_OBJECT (accessible)->showing)
+    atk_state_set_add_state (set, ATK_STATE_SHOWING);
+  return set;
+}
+
+static void
+test_object_finalize (GObject * gobj)
+{
+  g_ptr_array_free (TEST_OBJECT (gobj)->children, TRUE);
+  G_OBJECT_CLASS (test_object_parent_class)->finalize (gobj);
+}
+
+static void
+test_object_class_init (TestObjectClass * klass)
+{
+  AtkObjectClass *atk_class = ATK_OBJECT_CLASS (klass);
+
+  G_OBJECT_CLASS (klass)->finalize = test_object_finalize;
+  atk_class->get_n_children = test_object_get_n_children;
+  atk_class->ref_child = test_object_ref_child;
+  atk_class->ref_state_set = test_object_ref_state_set;
+}
+
+static void
+test_object_init (TestObject * object)
+{
+  object->children = g_ptr_array_new_with_free_func (g_object_unref);
+}
+
+static TestObject *
+test_object_new (TestObject * parent, gboolean showing)
+{
+  TestObject *object = g_object_new (test_object_get_type (), NULL);
+
+  object->showing = showing;
+  if (parent)
+    {
+      atk_object_set_parent (ATK_OBJECT (object), ATK_OBJECT (parent));
+      g_ptr_array_add (parent->children, object);
+    }
+  return object;
+}
+
+/*---------------------------------------------------------------------------*/
+
+gint
+spi_object_get_interfaces (AtkObject * obj, const gchar ** itfs)
+{
+  return 0;
+}
+
+AtspiRole
+spi_accessible_role_from_atk_role (AtkRole role)
+{
+  return ATSPI_ROLE_UNKNOWN;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void
+check (gboolean ok, const gchar * what)
+{
+  if (!ok)
+    {
+      g_print ("Failed: %s\n", what);
+      exit (1);
+    }
+}
+
+static void
+check_in_cache (TestObject * object, gboolean expected, const gchar * when)
+{
+  if (spi_cache_in (spi_global_cache, G_OBJECT (object)) != expected)
+    {
+      g_print ("Failed: child %s the cache %s\n",
+               expected ? "missing from" : "left in", when);
+      exit (1);
+    }
+}
+
+static void
+test_eviction (TestObject ** children)
+{
+  gint i;
+
+  check_in_cache (children[0], TRUE, "after the initial walk");
+  for (i = 1; i < N_CHILDREN; i++)
+    check_in_cache (children[i], FALSE, "after the initial walk");
+
+  /* An evicted child comes back once it is shown, though its parent
+   * never changes */
+  children[1]->showing = TRUE;
+  spi_cache_note_update (spi_global_cache, G_OBJECT (children[1]),
+                         SPI_CACHE_FIELD_STATES);
+  spi_cache_complete (spi_global_cache);
+  check_in_cache (children[1], TRUE, "after it was shown");
+
+  /* A child that is still hidden stays out */
+  spi_cache_note_update (spi_global_cache, G_OBJECT (children[2]),
+                         SPI_CACHE_FIELD_STATES | SPI_CACHE_FIELD_NAME);
+  spi_cache_complete (spi_global_cache);
+  check_in_cache (children[2], FALSE, "while it was hidden");
+}
+
+/*---------------------------------------------------------------------------*/
+
+static guint
+collect_since (guint32 generation, GArray * refs, GHashTable * kinds)
+{
+  g_array_set_size (refs, 0);
+  g_hash_table_remove_all (kinds);
+  if (!spi_cache_collect_changes_since (spi_global_cache, generation,
+                                        refs, kinds))
+    return G_MAXUINT;
+  return refs->len;
+}
+
+static SpiCacheChangeKind
+kind_of (GHashTable * kinds, guint64 ref)
+{
+  return GPOINTER_TO_UINT (g_hash_table_lookup (kinds, &ref));
+}
+
+/* Runs after test_eviction, with the root and two children cached */
+static void
+test_changes_since (TestObject * root, TestObject ** children)
+{
+  SpiCache *cache = spi_global_cache;
+  GArray *refs = g_array_new (FALSE, FALSE, sizeof (guint64));
+  GHashTable *kinds = g_hash_table_new (g_int64_hash, g_int64_equal);
+  guint64 shown = spi_register_object_to_ref (G_OBJECT (children[0]));
+  guint64 hidden = spi_register_object_to_ref (G_OBJECT (children[1]));
+  guint32 since = cache->generation;
+  guint log_length = cache->log->length;
+
+  check (collect_since (since, refs, kinds) == 0,
+         "changes reported with none made");
+  check (collect_since (since + 1, refs, kinds) == G_MAXUINT,
+         "changes reported since a future generation");
+
+  /* Updates to one object share a log entry and are reported once,
+   * at the position of the latest */
+  spi_cache_note_update (cache, G_OBJECT (children[0]), SPI_CACHE_FIELD_NAME);
+  spi_cache_note_update (cache, G_OBJECT (root), SPI_CACHE_FIELD_NAME);
+  spi_cache_note_update (cache, G_OBJECT (children[0]),
+                         SPI_CACHE_FIELD_DESCRIPTION);
+  check (cache->log->length == log_length + 2,
+         "repeated updates took more than one log entry");
+  check (collect_since (since, refs, kinds) == 2 &&
+         g_array_index (refs, guint64, 0) == 0 &&
+         g_array_index (refs, guint64, 1) == shown &&
+         kind_of (kinds, shown) == SPI_CACHE_CHANGE_UPDATE,
+         "updates not collapsed to one per object");
+
+  /* An object updated and then evicted is reported as removed */
+  children[1]->showing = FALSE;
+  spi_cache_note_update (cache, G_OBJECT (children[1]),
+                         SPI_CACHE_FIELD_STATES);
+  spi_cache_complete (cache);
+  check_in_cache (children[1], FALSE, "after it was hidden");
+  check (collect_since (since, refs, kinds) == 3 &&
+         g_array_index (refs, guint64, 2) == hidden &&
+         kind_of (kinds, hidden) == SPI_CACHE_CHANGE_REMOVE,
+         "an update and removal not collapsed to the removal");
+
+  /* Once the log is dropped earlier generations are too old */
+  spi_cache_invalidate (cache);
+  check (collect_since (since, refs, kinds) == G_MAXUINT,
+         "changes reported from before the log was dropped");
+  check (collect_since (cache->generation, refs, kinds) == 0,
+         "changes reported since the log was dropped");
+
+  g_hash_table_destroy (kinds);
+  g_array_free (refs, TRUE);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* A freed slot is reused, but the references to its last object fail */
+static void
+test_slot_reuse (void)
+{
+  TestObject *first, *second;
+  guint64 first_ref, second_ref;
+  gchar *first_path;
+
+  first = test_object_new (NULL, TRUE);
+  first_path = spi_register_object_to_path (spi_global_register,
+                                            G_OBJECT (first));
+  first_ref = spi_register_object_to_ref (G_OBJECT (first));
+  check (spi_register_path_to_object (spi_global_register, first_path) ==
+         G_OBJECT (first), "a registered object not found by its path");
+
+  /* Finalizing the object deregisters it and frees its slot */
+  g_object_unref (first);
+  second = test_object_new (NULL, TRUE);
+  spi_register_object_get_path (spi_global_register, G_OBJECT (second));
+  second_ref = spi_register_object_to_ref (G_OBJECT (second));
+
+  check ((guint32) second_ref == (guint32) first_ref && second_ref != first_ref,
+         "the freed slot not reused with a new generation");
+  check (spi_register_ref_to_object (spi_global_register, first_ref) == NULL,
+         "a reference to the last occupant of a slot accepted");
+  check (spi_register_path_to_object (spi_global_register, first_path) == NULL,
+         "a path to the last occupant of a slot accepted");
+  check (spi_register_ref_to_object (spi_global_register, second_ref) ==
+         G_OBJECT (second), "the new occupant of a slot not found");
+
+  g_free (first_path);
+  g_object_unref (second);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Records the removal of ref, last sent with parent and children. A
+ * negative n_children records it as never sent, and stale_children as
+ * sent with out of date children.
+ */
+static void
+add_removal (SpiRemovals * removals, guint64 ref, guint64 parent,
+             const guint64 * children, gint n_children,
+             gboolean stale_children)
+{
+  SpiCacheItem item = { 0, };
+  gchar *path = g_strdup_printf ("%" G_GUINT64_FORMAT, ref);
+
+  if (n_children < 0)
+    {
+      spi_removals_add (removals, ref, path, NULL);
+      return;
+    }
+
+  item.parent = parent;
+  item.has_parent = TRUE;
+  item.children = g_array_new (FALSE, FALSE, sizeof (guint64));
+  g_array_append_vals (item.children, children, n_children);
+  if (stale_children)
+    item.stale = SPI_CACHE_FIELD_CHILDREN;
+  spi_removals_add (removals, ref, path, &item);
+  g_array_free (item.children, TRUE);
+}
+
+static gchar *
+join_paths (GPtrArray * paths)
+{
+  g_ptr_array_add (paths, NULL);
+  return g_strjoinv (" ", (gchar **) paths->pdata);
+}
+
+static void
+check_sort (SpiRemovals * removals, const gchar * subtrees,
+            const gchar * singles, const gchar * what)
+{
+  GPtrArray *subtree_paths = g_ptr_array_new ();
+  GPtrArray *single_paths = g_ptr_array_new ();
+  gchar *got_subtrees, *got_singles;
+
+  spi_removals_sort (removals, subtree_paths, single_paths);
+  got_subtrees = join_paths (subtree_paths);
+  got_singles = join_paths (single_paths);
+  if (strcmp (got_subtrees, subtrees) || strcmp (got_singles, singles))
+    {
+      g_print ("Failed: %s: subtrees \"%s\" and singles \"%s\", "
+               "not \"%s\" and \"%s\"\n",
+               what, got_subtrees, got_singles, subtrees, singles);
+      exit (1);
+    }
+
+  g_free (got_subtrees);
+  g_free (got_singles);
+  g_ptr_array_free (subtree_paths, TRUE);
+  g_ptr_array_free (single_paths, TRUE);
+  spi_removals_clear (removals);
+}
+
+/*
+ * The branch 1 has children 2 and 3, and 2 has child 4. Children are
+ * removed before their parents, as when a window is destroyed.
+ */
+static void
+test_removals (void)
+{
+  SpiRemovals *removals = spi_removals_new ();
+  const guint64 children_of_1[] = { 2, 3 };
+  const guint64 children_of_2[] = { 4 };
+  const guint64 child_6[] = { 6 };
+  const guint64 child_7[] = { 7 };
+
+  /* A whole branch is one subtree */
+  add_removal (removals, 4, 2, NULL, 0, FALSE);
+  add_removal (removals, 2, 1, children_of_2, 1, FALSE);
+  add_removal (removals, 3, 1, NULL, 0, FALSE);
+  add_removal (removals, 1, 0, children_of_1, 2, FALSE);
+  check_sort (removals, "1", "", "a whole branch");
+
+  /* A child that stays makes its parent partial */
+  add_removal (removals, 4, 2, NULL, 0, FALSE);
+  add_removal (removals, 2, 1, children_of_2, 1, FALSE);
+  add_removal (removals, 1, 0, children_of_1, 2, FALSE);
+  check_sort (removals, "2", "1", "a branch with a child left");
+
+  /* So do children that clients may know of but were never sent */
+  add_removal (removals, 4, 2, NULL, 0, FALSE);
+  add_removal (removals, 2, 1, children_of_2, 1, FALSE);
+  add_removal (removals, 3, 1, NULL, 0, FALSE);
+  add_removal (removals, 1, 0, children_of_1, 2, TRUE);
+  check_sort (removals, "2", "3 1", "a branch with stale children");
+
+  /* A cycle is not a subtree, nor is an object never sent */
+  add_removal (removals, 6, 7, child_7, 1, FALSE);
+  add_removal (removals, 7, 6, child_6, 1, FALSE);
+  add_removal (removals, 8, 0, NULL, -1, FALSE);
+  check_sort (removals, "", "6 7 8", "a cycle and an unsent object");
+
+  spi_removals_free (removals);
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main (int argc, char **argv)
+{
+  TestObject *root, *children[N_CHILDREN];
+  gint i;
+
+  /* Room for the root and one child, so hidden children are evicted */
+  g_setenv ("ATK_BRIDGE_CACHE_MAX_OBJECTS", "2", TRUE);
+
+  root = test_object_new (NULL, TRUE);
+  children[0] = test_object_new (root, TRUE);
+  for (i = 1; i < N_CHILDREN; i++)
+    children[i] = test_object_new (root, FALSE);
+
+  spi_global_app_data = g_new0 (SpiBridge, 1);
+  spi_global_app_data->root = ATK_OBJECT (root);
+  spi_global_register = g_object_new (SPI_REGISTER_TYPE, NULL);
+  spi_global_leasing = g_object_new (SPI_LEASING_TYPE, NULL);
+  spi_global_cache = g_object_new (SPI_CACHE_TYPE, NULL);
+  spi_cache_complete (spi_global_cache);
+
+  test_eviction (children);
+  test_changes_since (root, children);
+  test_slot_reuse ();
+  test_removals ();
+
+  g_print ("Cache tests passed\n");
+  return 0;
+}
+
+/*END------------------------------------------------------------------------*/
@@ -32,6 +32,8 @@
 
 #include "bridge.h"
 #include "accessible-register.h"
+#include "accessible-leasing.h"
+#include "accessible-cache.h"
 
 #include "spi-dbus.h"
 #include "event.h"
@@ -51,19 +53,55 @@ static gint atk_bridge_focus_tracker_id;
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * The closure of a call made with send_and_allow_reentry. It is shared
+ * with the reply notification, which may come after the caller has
+ * given up waiting, and from the I/O thread's finalization of the
+ * pending call, so it is reference counted.
+ */
 typedef struct _SpiReentrantCallClosure 
 {
-  DBusConnection *bus;
+  gint ref_count;
   GMainLoop   *loop;
   DBusMessage *reply;
-  guint timeout;
+  gboolean done;
 } SpiReentrantCallClosure;
 
+static SpiReentrantCallClosure *
+closure_ref (SpiReentrantCallClosure *closure)
+{
+  g_atomic_int_inc (&closure->ref_count);
+  return closure;
+}
+
+static void
+closure_unref (void *data)
+{
+  SpiReentrantCallClosure *closure = data;
+
+  if (!g_atomic_int_dec_and_test (&closure->ref_count))
+    return;
+  if (closure->reply)
+    dbus_message_unref (closure->reply);
+  g_main_loop_unref (closure->loop);
+  g_free (closure);
+}
+
 static void
 switch_main_context (GMainContext *cnx)
 {
   GList *list;
 
+  /* The connections stay on the I/O thread; only the place where
+   * incoming calls are handled needs to follow the nested loop.
+   */
+  if (spi_global_app_data->io_thread)
+    {
+      droute_context_set_dispatch_context (spi_global_app_data->droute,
+                                           cnx ? cnx : g_main_context_default ());
+      return;
+    }
+
   if (spi_global_app_data->server)
     atspi_dbus_server_setup_with_g_main (spi_global_app_data->server, cnx);
   atspi_dbus_connection_setup_with_g_main (spi_global_app_data->bus, cnx);
@@ -72,14 +110,15 @@ switch_main_context (GMainContext *cnx)
     atspi_dbus_connection_setup_with_g_main (list->data, cnx);
 }
 
+/* Runs in the nested loop, whichever thread read the reply */
 static void
 set_reply (DBusPendingCall * pending, void *user_data)
 {
   SpiReentrantCallClosure* closure = (SpiReentrantCallClosure *) user_data; 
 
+  if (closure->done)
+    return;
   closure->reply = dbus_pending_call_steal_reply (pending);
-  dbus_pending_call_unref (pending);
-  switch_main_context (NULL);
   g_main_loop_quit (closure->loop);
 }
 
@@ -88,9 +127,7 @@ timeout_reply (void *data)
 {
   SpiReentrantCallClosure *closure = data;
 
-  switch_main_context (NULL);
   g_main_loop_quit (closure->loop);
-  closure->timeout = -1;
   return FALSE;
 }
 
@@ -98,12 +135,10 @@ static DBusMessage *
 send_and_allow_reentry (DBusConnection * bus, DBusMessage * message)
 {
   DBusPendingCall *pending;
-  SpiReentrantCallClosure closure;
+  SpiReentrantCallClosure *closure;
+  DBusMessage *reply;
   GSource *source;
 
-  closure.bus = bus;
-  closure.loop = g_main_loop_new (spi_global_app_data->main_context, FALSE);
-  closure.reply = NULL;
   switch_main_context (spi_global_app_data->main_context);
 
   if (!dbus_connection_send_with_reply (bus, message, &pending, 9000) || !pending)
@@ -111,19 +146,33 @@ send_and_allow_reentry (DBusConnection * bus, DBusMessage * message)
       switch_main_context (NULL);
       return NULL;
     }
-  dbus_pending_call_set_notify (pending, set_reply, (void *) &closure, NULL);
+
+  closure = g_new0 (SpiReentrantCallClosure, 1);
+  closure->ref_count = 1;
+  closure->loop = g_main_loop_new (spi_global_app_data->main_context, FALSE);
+
+  /* The notification has its own ref, dropped with the pending call */
+  spi_pending_call_set_notify (pending, set_reply, closure_ref (closure),
+                               closure_unref,
+                               spi_global_app_data->main_context);
   source = g_timeout_source_new (500);
-  g_source_set_callback (source, timeout_reply, &closure, NULL);
-  closure.timeout = g_source_attach (source, spi_global_app_data->main_context);
+  g_source_set_callback (source, timeout_reply, closure, NULL);
+  g_source_attach (source, spi_global_app_data->main_context);
+  g_main_loop_run  (closure->loop);
+  g_source_destroy (source);
   g_source_unref (source);
-  g_main_loop_run  (closure.loop);
-  if (closure.timeout != -1)
-    g_source_destroy (source);
-  
-  g_main_loop_unref (closure.loop);
-  if (!closure.reply)
+
+  switch_main_context (NULL);
+  closure->done = TRUE;
+  reply = closure->reply;
+  closure->reply = NULL;
+
+  /* The pending call ref from dbus_connection_send_with_reply is ours */
+  if (!reply)
     dbus_pending_call_cancel (pending);
-  return closure.reply;
+  dbus_pending_call_unref (pending);
+  closure_unref (closure);
+  return reply;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -470,7 +519,8 @@ emit_event (AtkObject  *obj,
             void (*append_variant) (DBusMessageIter *, const char *, const void *))
 {
   DBusConnection *bus = spi_global_app_data->bus;
-  char *path;
+  SpiObjectRecord *record;
+  const char *path;
   char *minor_dbus;
 
   gchar *cname;
@@ -486,7 +536,11 @@ emit_event (AtkObject  *obj,
   if (!signal_is_needed (klass, major, minor, &properties))
     return;
 
-  path =  spi_register_object_to_path (spi_global_register, G_OBJECT (obj));
+  record = spi_register_ensure (spi_global_register, G_OBJECT (obj));
+  if (record)
+    path = record->path;
+  else
+    path = spi_register_object_get_path (spi_global_register, G_OBJECT (obj));
   g_return_if_fail (path != NULL);
 
   /*
@@ -531,11 +585,16 @@ emit_event (AtkObject  *obj,
   dbus_connection_send(bus, sig, NULL);
   dbus_message_unref(sig);
 
+  /* The record may have gone if a property getter destroyed the object */
   if (g_strcmp0 (cname, "ChildrenChanged") != 0)
-    spi_object_lease_if_needed (G_OBJECT (obj));
+    {
+      if (!record)
+        spi_object_lease_if_needed (G_OBJECT (obj));
+      else if (record->gobj == G_OBJECT (obj) && !record->in_cache)
+        spi_leasing_take (spi_global_leasing, G_OBJECT (obj));
+    }
 
   g_free(cname);
-  g_free (path);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -582,6 +641,20 @@ property_event_listener (GSignalInvocationHint * signal_hint,
 
   pname = values[0].property_name;
 
+  /* These properties are part of the cached item */
+  if (strcmp (pname, "accessible-name") == 0)
+    spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                           SPI_CACHE_FIELD_NAME);
+  else if (strcmp (pname, "accessible-description") == 0)
+    spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                           SPI_CACHE_FIELD_DESCRIPTION);
+  else if (strcmp (pname, "accessible-parent") == 0)
+    spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                           SPI_CACHE_FIELD_PARENT);
+  else if (strcmp (pname, "accessible-role") == 0)
+    spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                           SPI_CACHE_FIELD_ROLE);
+
   /* TODO Could improve this control statement by matching
    * on only the end of the signal names,
    */
@@ -685,6 +758,14 @@ state_event_listener (GSignalInvocationHint * signal_hint,
   pname = g_value_get_string (&param_values[1]);
 
   detail1 = (g_value_get_boolean (&param_values[2])) ? 1 : 0;
+  /* Children are not sent for these states */
+  if (!g_strcmp0 (pname, "defunct") ||
+      !g_strcmp0 (pname, "manages-descendants"))
+    spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                           SPI_CACHE_FIELD_STATES | SPI_CACHE_FIELD_CHILDREN);
+  else
+    spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                           SPI_CACHE_FIELD_STATES);
   emit_event (accessible, ITF_EVENT_OBJECT, STATE_CHANGED, pname, detail1, 0,
               DBUS_TYPE_INT32_AS_STRING, 0, append_basic);
 
@@ -1066,6 +1147,10 @@ children_changed_event_listener (GSignalInvocationHint * signal_hint,
   detail1 = g_value_get_uint (param_values + 1);
   child = g_value_get_pointer (param_values + 2);
 
+  /* The cached item of the parent lists its children */
+  spi_cache_note_update (spi_global_cache, G_OBJECT (accessible),
+                         SPI_CACHE_FIELD_CHILDREN);
+
   if (ATK_IS_OBJECT (child))
     {
       ao = ATK_OBJECT (child);
@@ -0,0 +1,242 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * Copyright 2008 Novell, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Interfaces the bridge implements differently from the introspection
+ * data generated from at-spi2-core into introspection.c, which must not
+ * be edited. These are registered in place of the generated ones:
+ *
+ * Collection: the match rule is sent as (aiia{ss}iaiiasib), not the
+ *   (auuasuauusub) the generated data declares.
+ * Component: SetExtents takes its extents as one (iiii) struct.
+ * Cache: the bridge's own methods and signals for incremental, paged,
+ *   subtree and compact retrieval, batched changes and prefetching.
+ *
+ * gen-method-args.py reads this file after introspection.c, so the
+ * argument signatures droute checks follow these definitions.
+ */
+
+const char *spi_bridge_org_a11y_atspi_Collection = 
+"<interface name=\"org.a11y.atspi.Collection\" version=\"0.1.7\">"
+""
+"  <method name=\"GetMatches\">"
+"    <arg direction=\"in\" name=\"rule\" type=\"(aiia{ss}iaiiasib)\" />"
+"    "
+"    <arg direction=\"in\" name=\"sortby\" type=\"u\" />"
+"    <arg direction=\"in\" name=\"count\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"traverse\" type=\"b\" />"
+"    <arg direction=\"out\" type=\"a(so)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetMatchesTo\">"
+"    <arg direction=\"in\" name=\"current_object\" type=\"o\" />"
+"    "
+"    <arg direction=\"in\" name=\"rule\" type=\"(aiia{ss}iaiiasib)\" />"
+"    "
+"    <arg direction=\"in\" name=\"sortby\" type=\"u\" />"
+"    <arg direction=\"in\" name=\"tree\" type=\"u\" />"
+"    <arg direction=\"in\" name=\"limit_scope\" type=\"b\" />"
+"    <arg direction=\"in\" name=\"count\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"traverse\" type=\"b\" />"
+"    <arg direction=\"out\" type=\"a(so)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetMatchesFrom\">"
+"    <arg direction=\"in\" name=\"current_object\" type=\"o\" />"
+"    "
+"    <arg direction=\"in\" name=\"rule\" type=\"(aiia{ss}iaiiasib)\" />"
+"    "
+"    <arg direction=\"in\" name=\"sortby\" type=\"u\" />"
+"    <arg direction=\"in\" name=\"tree\" type=\"u\" />"
+"    <arg direction=\"in\" name=\"count\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"traverse\" type=\"b\" />"
+"    <arg direction=\"out\" type=\"a(so)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetActiveDescendant\">"
+"    <arg direction=\"out\" type=\"(so)\" />"
+"    "
+"  </method>"
+""
+"</interface>"
+"";
+
+const char *spi_bridge_org_a11y_atspi_Component = 
+"<interface name=\"org.a11y.atspi.Component\" version=\"0.1.7\">"
+""
+"  <method name=\"Contains\">"
+"    <arg direction=\"in\" name=\"x\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"y\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"coord_type\" type=\"u\" />"
+"    <arg direction=\"out\" type=\"b\" />"
+"  </method>"
+""
+"  <method name=\"GetAccessibleAtPoint\">"
+"    <arg direction=\"in\" name=\"x\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"y\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"coord_type\" type=\"u\" />"
+"    <arg direction=\"out\" type=\"(so)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetExtents\">"
+"    <arg direction=\"in\" name=\"coord_type\" type=\"u\" />"
+"    <arg direction=\"out\" type=\"(iiii)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetPosition\">"
+"    <arg direction=\"in\" name=\"coord_type\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"x\" type=\"i\" />"
+"    <arg direction=\"out\" name=\"y\" type=\"i\" />"
+"  </method>"
+""
+"  <method name=\"GetSize\">"
+"    <arg direction=\"out\" name=\"width\" type=\"i\" />"
+"    <arg direction=\"out\" name=\"height\" type=\"i\" />"
+"  </method>"
+""
+"  <method name=\"GetLayer\">"
+"    <arg direction=\"out\" type=\"u\" />"
+"  </method>"
+""
+"  <method name=\"GetMDIZOrder\">"
+"    <arg direction=\"out\" type=\"n\" />"
+"  </method>"
+""
+"  <method name=\"GrabFocus\">"
+"    <arg direction=\"out\" type=\"b\" />"
+"  </method>"
+""
+"  <method name=\"GetAlpha\">"
+"    <arg direction=\"out\" type=\"d\" />"
+"  </method>"
+""
+"  <method name=\"SetExtents\">"
+"    <arg direction=\"in\" name=\"extents\" type=\"(iiii)\" />"
+"    <arg direction=\"in\" name=\"coord_type\" type=\"u\" />"
+"    <arg direction=\"out\" type=\"b\" />"
+"  </method>"
+""
+"  <method name=\"SetPosition\">"
+"    <arg direction=\"in\" name=\"x\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"y\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"coord_type\" type=\"u\" />"
+"    <arg direction=\"out\" type=\"b\" />"
+"  </method>"
+""
+"  <method name=\"SetSize\">"
+"    <arg direction=\"in\" name=\"width\" type=\"i\" />"
+"    <arg direction=\"in\" name=\"height\" type=\"i\" />"
+"    <arg direction=\"out\" type=\"b\" />"
+"  </method>"
+""
+"</interface>"
+"";
+
+const char *spi_bridge_org_a11y_atspi_Cache = 
+"<interface name=\"org.a11y.atspi.Cache\" version=\"0.1.7\">"
+""
+"  <method name=\"GetItems\">"
+"    <arg direction=\"out\" name=\"nodes\" type=\"a((so)(so)a(so)assusau)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetItemsCompact\">"
+"    <arg direction=\"in\" name=\"fields\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"interfaces\" type=\"as\" />"
+"    <arg direction=\"out\" name=\"nodes\" type=\"a(ttatususau)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetItemsForSubtree\">"
+"    <arg direction=\"in\" name=\"root\" type=\"(so)\" />"
+"    <arg direction=\"in\" name=\"maxDepth\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"nodes\" type=\"a((so)(so)a(so)assusau)\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetItemsPage\">"
+"    <arg direction=\"in\" name=\"cursor\" type=\"u\" />"
+"    <arg direction=\"in\" name=\"maxItems\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"nodes\" type=\"a((so)(so)a(so)assusau)\" />"
+"    <arg direction=\"out\" name=\"nextCursor\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"generation\" type=\"u\" />"
+"    "
+"  </method>"
+""
+"  <method name=\"GetItemsSince\">"
+"    <arg direction=\"in\" name=\"generation\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"current\" type=\"u\" />"
+"    <arg direction=\"out\" name=\"tooOld\" type=\"b\" />"
+"    <arg direction=\"out\" name=\"nodes\" type=\"a((so)(so)a(so)assusau)\" />"
+"    <arg direction=\"out\" name=\"removed\" type=\"a(so)\" />"
+"    "
+"  </method>"
+""
+"  <signal name=\"AddAccessible\">"
+"    <arg name=\"nodeAdded\" type=\"((so)(so)a(so)assusau)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"AddAccessibles\">"
+"    <arg name=\"nodesAdded\" type=\"a((so)(so)a(so)assusau)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"AddAccessibleCompact\">"
+"    <arg name=\"nodeAdded\" type=\"(ttatususau)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"AddAccessiblesCompact\">"
+"    <arg name=\"nodesAdded\" type=\"a(ttatususau)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"RemoveAccessibles\">"
+"    <arg name=\"nodesRemoved\" type=\"a(so)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"RemoveSubtree\">"
+"    <arg name=\"root\" type=\"(so)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"RemoveAccessible\">"
+"    <arg name=\"nodeRemoved\" type=\"(so)\" />"
+"    "
+"  </signal>"
+""
+"  <signal name=\"Prefetch\">"
+"    <arg name=\"nodes\" type=\"a((so)(so)suau)\" />"
+"    "
+"  </signal>"
+""
+"</interface>"
+"";
+
+/*END------------------------------------------------------------------------*/
@@ -73,14 +73,14 @@ spi_object_lease_if_needed (GObject *obj)
  * All of them will lease the AtkObject if it is deemed neccessary.
  */
 
-void
-spi_object_append_null_reference (DBusMessageIter * iter)
+/*
+ * Appends a (so) reference. Both strings are borrowed: the bus name from
+ * the connection and the path from the register, so nothing is allocated.
+ */
+static void
+append_reference (DBusMessageIter * iter, const char *name, const char *path)
 {
   DBusMessageIter iter_struct;
-  const char *name;
-  const char *path = ATSPI_DBUS_PATH_NULL;
-
-  name = dbus_bus_get_unique_name (spi_global_app_data->bus);
 
   dbus_message_iter_open_container (iter, DBUS_TYPE_STRUCT, NULL,
                                     &iter_struct);
@@ -89,64 +89,136 @@ spi_object_append_null_reference (DBusMessageIter * iter)
   dbus_message_iter_close_container (iter, &iter_struct);
 }
 
+/*
+ * Returns the borrowed path of obj, registering it and leasing it
+ * if needed. Both are decided from the object's register record.
+ * A child already handed out with a virtual path keeps that path.
+ */
+static const char *
+reference_path (GObject * obj)
+{
+  SpiObjectRecord *record;
+  const gchar *path;
+
+  if ((void *) obj == (void *) spi_global_app_data->root)
+    {
+      spi_object_lease_if_needed (obj);
+      return spi_register_object_get_path (spi_global_register, obj);
+    }
+
+  path = spi_register_virtual_child_get_path (spi_global_register, obj);
+  if (path)
+    return path;
+
+  record = spi_register_ensure (spi_global_register, obj);
+  if (!record)
+    return SPI_DBUS_PATH_NULL;
+
+  if (!record->in_cache)
+    spi_leasing_take (spi_global_leasing, obj);
+  return record->path;
+}
+
 void
-spi_object_append_reference (DBusMessageIter * iter, AtkObject * obj)
+spi_object_append_null_reference (DBusMessageIter * iter)
 {
-  DBusMessageIter iter_struct;
-  const gchar *name;
-  gchar *path;
+  append_reference (iter, spi_global_app_data->bus_name, ATSPI_DBUS_PATH_NULL);
+}
 
+void
+spi_object_append_reference (DBusMessageIter * iter, AtkObject * obj)
+{
   if (!obj) {
     spi_object_append_null_reference (iter);
     return;
   }
 
-  spi_object_lease_if_needed (G_OBJECT (obj));
+  append_reference (iter, spi_global_app_data->bus_name,
+                    reference_path (G_OBJECT (obj)));
+}
 
-  name = dbus_bus_get_unique_name (spi_global_app_data->bus);
-  path = spi_register_object_to_path (spi_global_register, G_OBJECT (obj));
+gboolean
+spi_object_manages_descendants (AtkObject * obj)
+{
+  AtkStateSet *set = atk_object_ref_state_set (obj);
+  gboolean manages;
+
+  manages = atk_state_set_contains_state (set, ATK_STATE_MANAGES_DESCENDANTS);
+  g_object_unref (set);
+  return manages;
+}
+
+/*
+ * Appends a reference to child, a child of parent, which is expected to
+ * manage its descendants. Unless child is already registered the
+ * reference is virtual (see accessible-register.c): child is neither
+ * registered nor leased, so scrolling through a huge table does not grow
+ * the register.
+ */
+void
+spi_object_append_virtual_reference (DBusMessageIter * iter, AtkObject * parent,
+                                     AtkObject * child)
+{
+  const gchar *path = NULL;
+
+  if (child && !spi_register_lookup (spi_global_register, G_OBJECT (child)))
+    path = spi_register_virtual_child_to_path (spi_global_register,
+                                               G_OBJECT (parent),
+                                               G_OBJECT (child));
 
   if (!path)
-    path = g_strdup (SPI_DBUS_PATH_NULL);
+    {
+      spi_object_append_reference (iter, child);
+      return;
+    }
 
-  dbus_message_iter_open_container (iter, DBUS_TYPE_STRUCT, NULL,
-                                    &iter_struct);
-  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &name);
-  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH, &path);
-  dbus_message_iter_close_container (iter, &iter_struct);
-  
-  g_free (path);
+  append_reference (iter, spi_global_app_data->bus_name, path);
 }
 
-/* TODO: Perhaps combine with spi_object_append_reference.  Leaving separate
- * for now in case we want to use a different path for hyperlinks. */
+/*
+ * The same references, written straight into a DRouteWire.
+ */
 void
-spi_hyperlink_append_reference (DBusMessageIter * iter, AtkHyperlink * obj)
+spi_object_wire_append_null_reference (DRouteWire * wire)
 {
-  DBusMessageIter iter_struct;
-  const gchar *name;
-  gchar *path;
+  droute_wire_open_struct (wire);
+  droute_wire_append_string (wire, spi_global_app_data->bus_name);
+  droute_wire_append_string (wire, ATSPI_DBUS_PATH_NULL);
+}
 
+void
+spi_object_wire_append_reference (DRouteWire * wire, AtkObject * obj)
+{
   if (!obj) {
-    spi_object_append_null_reference (iter);
+    spi_object_wire_append_null_reference (wire);
     return;
   }
 
-  spi_object_lease_if_needed (G_OBJECT (obj));
+  droute_wire_open_struct (wire);
+  droute_wire_append_string (wire, spi_global_app_data->bus_name);
+  droute_wire_append_string (wire, reference_path (G_OBJECT (obj)));
+}
 
-  name = dbus_bus_get_unique_name (spi_global_app_data->bus);
-  path = spi_register_object_to_path (spi_global_register, G_OBJECT (obj));
+void
+spi_object_wire_append_desktop_reference (DRouteWire * wire)
+{
+  droute_wire_open_struct (wire);
+  droute_wire_append_string (wire, spi_global_app_data->desktop_name);
+  droute_wire_append_string (wire, spi_global_app_data->desktop_path);
+}
 
-  if (!path)
-    path = g_strdup (SPI_DBUS_PATH_NULL);
+/* TODO: Perhaps combine with spi_object_append_reference.  Leaving separate
+ * for now in case we want to use a different path for hyperlinks. */
+void
+spi_hyperlink_append_reference (DBusMessageIter * iter, AtkHyperlink * obj)
+{
+  if (!obj) {
+    spi_object_append_null_reference (iter);
+    return;
+  }
 
-  dbus_message_iter_open_container (iter, DBUS_TYPE_STRUCT, NULL,
-                                    &iter_struct);
-  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &name);
-  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH, &path);
-  dbus_message_iter_close_container (iter, &iter_struct);
-  
-  g_free (path);
+  append_reference (iter, spi_global_app_data->bus_name,
+                    reference_path (G_OBJECT (obj)));
 }
 
 void
@@ -163,15 +235,8 @@ spi_object_append_v_reference (DBusMessageIter * iter, AtkObject * obj)
 void
 spi_object_append_desktop_reference (DBusMessageIter * iter)
 {
-  DBusMessageIter iter_struct;
-  const char *name = spi_global_app_data->desktop_name;
-  const char *path = spi_global_app_data->desktop_path;
-
-  dbus_message_iter_open_container (iter, DBUS_TYPE_STRUCT, NULL,
-                                    &iter_struct);
-  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &name);
-  dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH, &path);
-  dbus_message_iter_close_container (iter, &iter_struct);
+  append_reference (iter, spi_global_app_data->desktop_name,
+                    spi_global_app_data->desktop_path);
 }
 
 DBusMessage *
@@ -190,6 +255,30 @@ spi_object_return_reference (DBusMessage * msg, AtkObject * obj)
   return reply;
 }
 
+/*
+ * Returns a reference to child, a child of parent, virtual if parent
+ * manages its descendants.
+ */
+DBusMessage *
+spi_object_return_child_reference (DBusMessage * msg, AtkObject * parent,
+                                   AtkObject * child)
+{
+  DBusMessage *reply;
+
+  if (!child || !spi_object_manages_descendants (parent))
+    return spi_object_return_reference (msg, child);
+
+  reply = dbus_message_new_method_return (msg);
+  if (reply)
+    {
+      DBusMessageIter iter;
+      dbus_message_iter_init_append (reply, &iter);
+      spi_object_append_virtual_reference (&iter, parent, child);
+    }
+
+  return reply;
+}
+
 DBusMessage *
 spi_hyperlink_return_reference (DBusMessage * msg, AtkHyperlink * obj)
 {
@@ -210,105 +299,77 @@ spi_hyperlink_return_reference (DBusMessage * msg, AtkHyperlink * obj)
 
 /*---------------------------------------------------------------------------*/
 
-void
-spi_object_append_interfaces (DBusMessageIter * iter, AtkObject * obj)
+/*
+ * Fills itfs, which must have room for SPI_OBJECT_MAX_INTERFACES
+ * entries, with the D-Bus interfaces obj implements. Returns how many
+ * were stored.
+ */
+gint
+spi_object_get_interfaces (AtkObject * obj, const gchar ** itfs)
 {
-  const gchar *itf;
+  gint n = 0;
 
-  itf = ATSPI_DBUS_INTERFACE_ACCESSIBLE;
-  dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
+  itfs[n++] = ATSPI_DBUS_INTERFACE_ACCESSIBLE;
 
   if (ATK_IS_ACTION (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_ACTION;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_ACTION;
 
   if (atk_object_get_role (obj) == ATK_ROLE_APPLICATION)
-    {
-      itf = ATSPI_DBUS_INTERFACE_APPLICATION;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_APPLICATION;
 
   if (ATK_IS_COMPONENT (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_COMPONENT;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_COMPONENT;
 
   if (ATK_IS_EDITABLE_TEXT (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_EDITABLE_TEXT;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_EDITABLE_TEXT;
 
   if (ATK_IS_TEXT (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_TEXT;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_TEXT;
 
   if (ATK_IS_HYPERTEXT (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_HYPERTEXT;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_HYPERTEXT;
 
   if (ATK_IS_IMAGE (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_IMAGE;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_IMAGE;
 
   if (ATK_IS_SELECTION (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_SELECTION;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_SELECTION;
 
   if (ATK_IS_TABLE (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_TABLE;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_TABLE;
 
   if (ATK_IS_TABLE_CELL (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_TABLE_CELL;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_TABLE_CELL;
 
   if (ATK_IS_VALUE (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_VALUE;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_VALUE;
 
 #if 0
   if (ATK_IS_STREAMABLE_CONTENT (obj))
-    {
-      itf = "org.a11y.atspi.StreamableContent";
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = "org.a11y.atspi.StreamableContent";
 #endif
 
   if (ATK_IS_OBJECT (obj))
-    {
-      itf = "org.a11y.atspi.Collection";
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = "org.a11y.atspi.Collection";
 
   if (ATK_IS_DOCUMENT (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_DOCUMENT;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_DOCUMENT;
 
   if (ATK_IS_HYPERLINK_IMPL (obj))
-    {
-      itf = ATSPI_DBUS_INTERFACE_HYPERLINK;
-      dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itf);
-    }
+    itfs[n++] = ATSPI_DBUS_INTERFACE_HYPERLINK;
+
+  return n;
+}
+
+void
+spi_object_append_interfaces (DBusMessageIter * iter, AtkObject * obj)
+{
+  const gchar *itfs[SPI_OBJECT_MAX_INTERFACES];
+  gint i, n;
+
+  n = spi_object_get_interfaces (obj, itfs);
+  for (i = 0; i < n; i++)
+    dbus_message_iter_append_basic (iter, DBUS_TYPE_STRING, &itfs[i]);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -26,6 +26,10 @@
 
 #include <atk/atk.h>
 #include <dbus/dbus.h>
+#include <droute/droute.h>
+
+/* Room needed by spi_object_get_interfaces */
+#define SPI_OBJECT_MAX_INTERFACES (16)
 
 void
 spi_object_lease_if_needed (GObject *obj);
@@ -33,6 +37,13 @@ spi_object_lease_if_needed (GObject *obj);
 void
 spi_object_append_reference (DBusMessageIter * iter, AtkObject * obj);
 
+gboolean
+spi_object_manages_descendants (AtkObject * obj);
+
+void
+spi_object_append_virtual_reference (DBusMessageIter * iter, AtkObject * parent,
+                                     AtkObject * child);
+
 void
 spi_hyperlink_append_reference (DBusMessageIter * iter, AtkObject * obj);
 
@@ -45,12 +56,28 @@ spi_object_append_desktop_reference (DBusMessageIter * iter);
 void
 spi_object_append_null_reference (DBusMessageIter * iter);
 
+void
+spi_object_wire_append_reference (DRouteWire * wire, AtkObject * obj);
+
+void
+spi_object_wire_append_desktop_reference (DRouteWire * wire);
+
+void
+spi_object_wire_append_null_reference (DRouteWire * wire);
+
 DBusMessage *
 spi_object_return_reference (DBusMessage * msg, AtkObject * obj);
 
+DBusMessage *
+spi_object_return_child_reference (DBusMessage * msg, AtkObject * parent,
+                                   AtkObject * child);
+
 DBusMessage *
 spi_hyperlink_return_reference (DBusMessage * msg, AtkHyperlink * obj);
 
+gint
+spi_object_get_interfaces (AtkObject * obj, const gchar ** itfs);
+
 void
 spi_object_append_interfaces (DBusMessageIter * iter, AtkObject * obj);
 
@@ -0,0 +1,848 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+/*
+ * droute-bench: measures droute dispatch over a private connection.
+ *
+ * The process forks. The child serves N object paths, each with M
+ * interfaces, through droute on a peer-to-peer connection, and the
+ * parent drives a mix of method calls, Properties.Get, Properties.GetAll
+ * and Introspect against it, one call in flight at a time. The report
+ * gives messages per second, latency percentiles per kind of call and
+ * the number of allocations the server made per call.
+ *
+ * It then times method lookups through droute's dispatch tables against
+ * the StrPair hash table droute used previously, and building a reply of
+ * cache-like items, the kind GetItems sends, through DBusMessageIter and
+ * through DRouteWire.
+ *
+ *   droute-bench --paths=1000 --interfaces=8 --calls=50000 \
+ *                --mix=call:70,get:10,getall:10,introspect:10 \
+ *                --lookups=1000000 --wire-items=100000
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <glib.h>
+#include <droute/droute.h>
+#include <droute/droute-pairhash.h>
+
+#include "atspi/atspi.h"
+
+#define BENCH_OBJECT_PATH     "/bench/object"
+#define BENCH_CONTROL_PATH    "/bench/control"
+#define BENCH_CONTROL_IFACE   "bench.Control"
+#define BENCH_INTERFACE       "bench.Interface%u"
+#define BENCH_LISTEN_ADDRESS  "unix:tmpdir=/tmp"
+
+typedef enum
+{
+    BENCH_CALL,
+    BENCH_GET,
+    BENCH_GET_ALL,
+    BENCH_INTROSPECT,
+    BENCH_N_KINDS
+} BenchKind;
+
+static const gchar *kind_names[BENCH_N_KINDS] =
+{
+    "call", "get", "getall", "introspect"
+};
+
+typedef struct _BenchObject
+{
+    dbus_uint32_t index;
+} BenchObject;
+
+static gint n_paths = 1000;
+static gint n_interfaces = 8;
+static gint n_calls = 20000;
+static gint n_warmup = 1000;
+static gint seed = 1;
+static gchar *mix = "call:70,get:10,getall:10,introspect:10";
+static gint n_lookups = 1000000;
+static gint n_wire_items = 100000;
+
+static GOptionEntry entries[] =
+{
+    { "paths", 'n', 0, G_OPTION_ARG_INT, &n_paths,
+      "Number of object paths to serve", "N" },
+    { "interfaces", 'm', 0, G_OPTION_ARG_INT, &n_interfaces,
+      "Number of interfaces on every path", "M" },
+    { "calls", 'c', 0, G_OPTION_ARG_INT, &n_calls,
+      "Number of timed calls", "COUNT" },
+    { "warmup", 'w', 0, G_OPTION_ARG_INT, &n_warmup,
+      "Number of untimed calls made first", "COUNT" },
+    { "mix", 0, 0, G_OPTION_ARG_STRING, &mix,
+      "Weights of call, get, getall and introspect", "KIND:WEIGHT,..." },
+    { "seed", 0, 0, G_OPTION_ARG_INT, &seed,
+      "Seed choosing the calls, so that runs can be compared", "SEED" },
+    { "lookups", 0, 0, G_OPTION_ARG_INT, &n_lookups,
+      "Number of timed method lookups, or 0 to skip them", "COUNT" },
+    { "wire-items", 0, 0, G_OPTION_ARG_INT, &n_wire_items,
+      "Number of items in the timed reply, or 0 to skip it", "COUNT" },
+    { NULL }
+};
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Counts allocations made through malloc, so that the server can report
+ * how many a call cost. configure checks for the entry points needed to
+ * wrap the allocator, which glibc offers; without them nothing is
+ * counted.
+ */
+static volatile gsize allocations;
+
+#ifdef HAVE_LIBC_ALLOCATOR
+extern void *__libc_malloc  (size_t size);
+extern void *__libc_calloc  (size_t n, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+void *
+malloc (size_t size)
+{
+    allocations++;
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t n, size_t size)
+{
+    allocations++;
+    return __libc_calloc (n, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+    allocations++;
+    return __libc_realloc (ptr, size);
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+static DBusMessage *
+impl_Echo (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DBusMessage *reply;
+    dbus_uint32_t value;
+
+    dbus_message_get_args (message, NULL, DBUS_TYPE_UINT32, &value,
+                           DBUS_TYPE_INVALID);
+    reply = dbus_message_new_method_return (message);
+    dbus_message_append_args (reply, DBUS_TYPE_UINT32, &value,
+                              DBUS_TYPE_INVALID);
+    return reply;
+}
+
+static DBusMessage *
+impl_Null (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    return dbus_message_new_method_return (message);
+}
+
+static dbus_bool_t
+impl_get_Index (DBusMessageIter *iter, void *user_data)
+{
+    BenchObject *object = user_data;
+
+    return droute_return_v_int32 (iter, object->index);
+}
+
+static dbus_bool_t
+impl_get_Name (DBusMessageIter *iter, void *user_data)
+{
+    return droute_return_v_string (iter, "bench");
+}
+
+static DRouteMethod bench_methods[] = {
+    {impl_Echo, "Echo", DBUS_TYPE_UINT32_AS_STRING},
+    {impl_Null, "Null", ""},
+    {NULL, NULL}
+};
+
+static DRouteProperty bench_properties[] = {
+    {impl_get_Index, NULL, "Index"},
+    {impl_get_Name, NULL, "Name"},
+    {NULL, NULL, NULL}
+};
+
+static const gchar *bench_introspection =
+"<interface name=\"%s\">"
+"  <method name=\"Echo\">"
+"    <arg direction=\"in\" type=\"u\"/>"
+"    <arg direction=\"out\" type=\"u\"/>"
+"  </method>"
+"  <method name=\"Null\"/>"
+"  <property name=\"Index\" type=\"i\" access=\"read\"/>"
+"  <property name=\"Name\" type=\"s\" access=\"read\"/>"
+"</interface>";
+
+static DBusMessage *
+impl_GetAllocations (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DBusMessage *reply;
+    dbus_uint64_t count = allocations;
+
+    reply = dbus_message_new_method_return (message);
+    dbus_message_append_args (reply, DBUS_TYPE_UINT64, &count,
+                              DBUS_TYPE_INVALID);
+    return reply;
+}
+
+static DRouteMethod control_methods[] = {
+    {impl_GetAllocations, "GetAllocations", ""},
+    {NULL, NULL}
+};
+
+static DRouteProperty no_properties[] = {
+    {NULL, NULL, NULL}
+};
+
+/*---------------------------------------------------------------------------*/
+
+static BenchObject *objects;
+static GMainLoop   *server_loop;
+
+static void *
+get_object (const char *path, void *user_data)
+{
+    const gchar *tail;
+    gchar *end;
+    guint64 index;
+
+    if (strncmp (path, BENCH_OBJECT_PATH "/", strlen (BENCH_OBJECT_PATH) + 1))
+        return NULL;
+    tail = path + strlen (BENCH_OBJECT_PATH) + 1;
+    index = g_ascii_strtoull (tail, &end, 10);
+    if (end == tail || *end || index >= (guint64) n_paths)
+        return NULL;
+    return &objects[index];
+}
+
+static DBusHandlerResult
+server_filter (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    if (dbus_message_is_signal (message, DBUS_INTERFACE_LOCAL, "Disconnected"))
+        g_main_loop_quit (server_loop);
+    return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+}
+
+static void
+server_new_connection (DBusServer *server, DBusConnection *bus, void *data)
+{
+    DRouteContext *cnx = data;
+
+    dbus_connection_ref (bus);
+    atspi_dbus_connection_setup_with_g_main (bus, NULL);
+    dbus_connection_add_filter (bus, server_filter, NULL, NULL);
+    droute_context_register (cnx, bus);
+}
+
+/*
+ * Serves the benchmark objects until the client disconnects. The
+ * listening address is written to fd first.
+ */
+static void
+run_server (int fd)
+{
+    DRouteContext *cnx;
+    DRoutePath *path;
+    DBusServer *server;
+    DBusError error;
+    gchar *address;
+    guint i;
+
+    objects = g_new (BenchObject, n_paths);
+    for (i = 0; i < (guint) n_paths; i++)
+        objects[i].index = i;
+
+    cnx = droute_new ();
+    path = droute_add_many (cnx, BENCH_OBJECT_PATH, NULL, NULL, NULL,
+                            get_object);
+    for (i = 0; i < (guint) n_interfaces; i++)
+      {
+        gchar *name = g_strdup_printf (BENCH_INTERFACE, i);
+        gchar *xml = g_strdup_printf (bench_introspection, name);
+
+        /* droute keeps the introspection data, so xml is not freed */
+        droute_path_add_interface (path, name, xml, bench_methods,
+                                   bench_properties);
+        g_free (name);
+      }
+
+    path = droute_add_one (cnx, BENCH_CONTROL_PATH, NULL);
+    droute_path_add_interface (path, BENCH_CONTROL_IFACE, "", control_methods,
+                               no_properties);
+
+    dbus_error_init (&error);
+    server = dbus_server_listen (BENCH_LISTEN_ADDRESS, &error);
+    if (!server)
+      {
+        g_printerr ("droute-bench: %s\n", error.message);
+        exit (1);
+      }
+
+    server_loop = g_main_loop_new (NULL, FALSE);
+    dbus_server_set_new_connection_function (server, server_new_connection,
+                                             cnx, NULL);
+    atspi_dbus_server_setup_with_g_main (server, NULL);
+
+    address = dbus_server_get_address (server);
+    if (write (fd, address, strlen (address) + 1) < 0)
+        exit (1);
+    close (fd);
+    dbus_free (address);
+
+    g_main_loop_run (server_loop);
+
+    dbus_server_disconnect (server);
+    dbus_server_unref (server);
+    exit (0);
+}
+
+/*---------------------------------------------------------------------------*/
+
+static gboolean
+parse_mix (const gchar *spec, guint weights[BENCH_N_KINDS])
+{
+    gchar **parts;
+    guint i, k, total = 0;
+    gboolean ok = TRUE;
+
+    memset (weights, 0, sizeof (guint) * BENCH_N_KINDS);
+    parts = g_strsplit (spec, ",", -1);
+    for (i = 0; ok && parts[i]; i++)
+      {
+        gchar *colon = strchr (parts[i], ':');
+
+        ok = FALSE;
+        if (!colon)
+            break;
+        *colon = '\0';
+        for (k = 0; k < BENCH_N_KINDS; k++)
+            if (!strcmp (parts[i], kind_names[k]))
+              {
+                weights[k] = atoi (colon + 1);
+                total += weights[k];
+                ok = TRUE;
+              }
+      }
+    g_strfreev (parts);
+    return ok && total > 0;
+}
+
+static BenchKind
+pick_kind (GRand *rand, const guint weights[BENCH_N_KINDS])
+{
+    guint total = 0, n;
+    BenchKind k;
+
+    for (k = 0; k < BENCH_N_KINDS; k++)
+        total += weights[k];
+    n = g_rand_int_range (rand, 0, total);
+    for (k = 0; n >= weights[k]; k++)
+        n -= weights[k];
+    return k;
+}
+
+static DBusMessage *
+new_bench_message (BenchKind kind, GRand *rand)
+{
+    DBusMessage *message = NULL;
+    dbus_uint32_t index = g_rand_int_range (rand, 0, n_paths);
+    gchar *path = g_strdup_printf (BENCH_OBJECT_PATH "/%u", index);
+    gchar *iface = g_strdup_printf (BENCH_INTERFACE,
+                                    g_rand_int_range (rand, 0, n_interfaces));
+    const char *property = "Index";
+
+    switch (kind)
+      {
+        case BENCH_CALL:
+          message = dbus_message_new_method_call (NULL, path, iface, "Echo");
+          dbus_message_append_args (message, DBUS_TYPE_UINT32, &index,
+                                    DBUS_TYPE_INVALID);
+          break;
+        case BENCH_GET:
+          message = dbus_message_new_method_call (NULL, path,
+                                                  DBUS_INTERFACE_PROPERTIES,
+                                                  "Get");
+          dbus_message_append_args (message, DBUS_TYPE_STRING, &iface,
+                                    DBUS_TYPE_STRING, &property,
+                                    DBUS_TYPE_INVALID);
+          break;
+        case BENCH_GET_ALL:
+          message = dbus_message_new_method_call (NULL, path,
+                                                  DBUS_INTERFACE_PROPERTIES,
+                                                  "GetAll");
+          dbus_message_append_args (message, DBUS_TYPE_STRING, &iface,
+                                    DBUS_TYPE_INVALID);
+          break;
+        default:
+          message = dbus_message_new_method_call (NULL, path,
+                                                  DBUS_INTERFACE_INTROSPECTABLE,
+                                                  "Introspect");
+          break;
+      }
+
+    g_free (path);
+    g_free (iface);
+    return message;
+}
+
+static dbus_uint64_t
+get_allocations (DBusConnection *bus)
+{
+    DBusMessage *message, *reply;
+    dbus_uint64_t count = 0;
+
+    message = dbus_message_new_method_call (NULL, BENCH_CONTROL_PATH,
+                                            BENCH_CONTROL_IFACE,
+                                            "GetAllocations");
+    reply = dbus_connection_send_with_reply_and_block (bus, message, -1, NULL);
+    if (reply)
+      {
+        dbus_message_get_args (reply, NULL, DBUS_TYPE_UINT64, &count,
+                               DBUS_TYPE_INVALID);
+        dbus_message_unref (reply);
+      }
+    dbus_message_unref (message);
+    return count;
+}
+
+static gint
+compare_samples (gconstpointer a, gconstpointer b)
+{
+    gint64 x = *(const gint64 *) a, y = *(const gint64 *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+/* samples must be sorted */
+static gint64
+percentile (GArray *samples, gdouble p)
+{
+    if (!samples->len)
+        return 0;
+    return g_array_index (samples, gint64, (guint) ((samples->len - 1) * p));
+}
+
+static void
+print_latencies (const gchar *name, GArray *samples)
+{
+    g_array_sort (samples, compare_samples);
+    g_print ("%-10s %8u %8" G_GINT64_FORMAT " %8" G_GINT64_FORMAT
+             " %8" G_GINT64_FORMAT " %8" G_GINT64_FORMAT "\n",
+             name, samples->len,
+             percentile (samples, 0.5), percentile (samples, 0.9),
+             percentile (samples, 0.99), percentile (samples, 1.0));
+}
+
+/*
+ * Makes the calls, one at a time, and reports on them. Returns the
+ * number of calls that got an error back.
+ */
+static guint
+run_client (DBusConnection *bus)
+{
+    guint weights[BENCH_N_KINDS];
+    GArray *samples[BENCH_N_KINDS], *all;
+    GRand *rand;
+    dbus_uint64_t allocations_before = 0, allocations_after;
+    gint64 start = 0, elapsed;
+    guint i, failures = 0;
+    BenchKind k;
+
+    parse_mix (mix, weights);
+    rand = g_rand_new_with_seed (seed);
+    for (k = 0; k < BENCH_N_KINDS; k++)
+        samples[k] = g_array_sized_new (FALSE, FALSE, sizeof (gint64), n_calls);
+    all = g_array_sized_new (FALSE, FALSE, sizeof (gint64), n_calls);
+
+    for (i = 0; i < (guint) (n_warmup + n_calls); i++)
+      {
+        DBusMessage *message, *reply;
+        gint64 sent, latency;
+
+        if (i == (guint) n_warmup)
+          {
+            allocations_before = get_allocations (bus);
+            start = g_get_monotonic_time ();
+          }
+
+        k = pick_kind (rand, weights);
+        message = new_bench_message (k, rand);
+        sent = g_get_monotonic_time ();
+        reply = dbus_connection_send_with_reply_and_block (bus, message, -1,
+                                                           NULL);
+        latency = g_get_monotonic_time () - sent;
+        dbus_message_unref (message);
+
+        if (!reply || dbus_message_get_type (reply) == DBUS_MESSAGE_TYPE_ERROR)
+            failures++;
+        if (reply)
+            dbus_message_unref (reply);
+
+        if (i >= (guint) n_warmup)
+          {
+            g_array_append_val (samples[k], latency);
+            g_array_append_val (all, latency);
+          }
+      }
+
+    elapsed = MAX (g_get_monotonic_time () - start, 1);
+    allocations_after = get_allocations (bus);
+
+    g_print ("%d paths, %d interfaces, %d calls, mix %s\n",
+             n_paths, n_interfaces, n_calls, mix);
+    g_print ("Messages/s: %.0f\n",
+             n_calls * (gdouble) G_USEC_PER_SEC / elapsed);
+#ifdef HAVE_LIBC_ALLOCATOR
+    /* The GetAllocations call made at the end is counted too */
+    g_print ("Server allocations/call: %.1f\n",
+             (allocations_after - allocations_before) / (gdouble) n_calls);
+#else
+    g_print ("Server allocations/call: not counted on this platform\n");
+#endif
+    g_print ("\n%-10s %8s %8s %8s %8s %8s\n",
+             "latency", "count", "p50 us", "p90 us", "p99 us", "max us");
+    for (k = 0; k < BENCH_N_KINDS; k++)
+        if (samples[k]->len)
+            print_latencies (kind_names[k], samples[k]);
+    print_latencies ("all", all);
+
+    for (k = 0; k < BENCH_N_KINDS; k++)
+        g_array_free (samples[k], TRUE);
+    g_array_free (all, TRUE);
+    g_rand_free (rand);
+    return failures;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Times resolving (interface, member) for the methods of the server's
+ * interfaces, through the sorted dispatch tables and through a StrPair
+ * hash table. Returns FALSE if either misses a method.
+ */
+static gboolean
+run_lookups (void)
+{
+    DRouteContext *cnx;
+    DRoutePath *path;
+    GHashTable *legacy;
+    GPtrArray *names, *queries;
+    gint64 start;
+    gdouble legacy_rate, droute_rate;
+    guint i, legacy_found = 0, droute_found = 0;
+    const DRouteMethod *m;
+
+    cnx = droute_new ();
+    path = droute_add_one (cnx, BENCH_OBJECT_PATH, NULL);
+    legacy = g_hash_table_new_full (str_pair_hash, str_pair_equal,
+                                    g_free, NULL);
+    names = g_ptr_array_new_with_free_func (g_free);
+    queries = g_ptr_array_new ();
+    for (i = 0; i < (guint) n_interfaces; i++)
+      {
+        gchar *name = g_strdup_printf (BENCH_INTERFACE, i);
+
+        g_ptr_array_add (names, name);
+        droute_path_add_interface (path, name, "", bench_methods,
+                                   bench_properties);
+        for (m = bench_methods; m->name != NULL; m++)
+          {
+            g_hash_table_insert (legacy, str_pair_new (name, m->name),
+                                 m->func);
+            /* Copies, so that no lookup can benefit from pointer equality */
+            g_ptr_array_add (queries, str_pair_new (g_strdup (name),
+                                                    g_strdup (m->name)));
+          }
+      }
+
+    start = g_get_monotonic_time ();
+    for (i = 0; i < (guint) n_lookups; i++)
+      {
+        StrPair *pair = g_ptr_array_index (queries, i % queries->len);
+
+        if (g_hash_table_lookup (legacy, pair))
+            legacy_found++;
+      }
+    legacy_rate = n_lookups * (gdouble) G_USEC_PER_SEC /
+                  MAX (g_get_monotonic_time () - start, 1);
+
+    start = g_get_monotonic_time ();
+    for (i = 0; i < (guint) n_lookups; i++)
+      {
+        StrPair *pair = g_ptr_array_index (queries, i % queries->len);
+
+        if (droute_path_get_method (path, pair->one, pair->two))
+            droute_found++;
+      }
+    droute_rate = n_lookups * (gdouble) G_USEC_PER_SEC /
+                  MAX (g_get_monotonic_time () - start, 1);
+
+    g_print ("\nLookups/s: StrPair hash %.0f, sorted tables %.0f\n",
+             legacy_rate, droute_rate);
+
+    for (i = 0; i < queries->len; i++)
+      {
+        StrPair *pair = g_ptr_array_index (queries, i);
+
+        g_free ((gchar *) pair->one);
+        g_free ((gchar *) pair->two);
+        g_free (pair);
+      }
+    g_ptr_array_free (queries, TRUE);
+    g_hash_table_destroy (legacy);
+    droute_free (cnx);
+    g_ptr_array_free (names, TRUE);
+
+    if (legacy_found != (guint) n_lookups || droute_found != (guint) n_lookups)
+      {
+        g_print ("Failed: lookups missed a method\n");
+        return FALSE;
+      }
+    return TRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static const gchar *wire_interfaces[] = { "org.a11y.atspi.Accessible",
+                                          "org.a11y.atspi.Component" };
+
+/*
+ * Items are ((so)a(so)asu): a reference, up to two child references, one
+ * or two interfaces and a role.
+ */
+static DBusMessage *
+build_iter_reply (DBusMessage *call, guint n_items)
+{
+    DBusMessage *reply;
+    DBusMessageIter iter, iter_array, iter_struct, iter_sub, iter_ref;
+    const gchar *name = ":1.42";
+    gchar path[64];
+    guint i, j;
+
+    reply = dbus_message_new_method_return (call);
+    dbus_message_iter_init_append (reply, &iter);
+    dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY, "((so)a(so)asu)",
+                                      &iter_array);
+    for (i = 0; i < n_items; i++)
+      {
+        const gchar *p = path;
+        dbus_uint32_t role = i % 100;
+
+        g_snprintf (path, sizeof (path), "/org/a11y/atspi/accessible/%u", i);
+        dbus_message_iter_open_container (&iter_array, DBUS_TYPE_STRUCT, NULL,
+                                          &iter_struct);
+        dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_STRUCT, NULL,
+                                          &iter_ref);
+        dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_STRING, &name);
+        dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_OBJECT_PATH, &p);
+        dbus_message_iter_close_container (&iter_struct, &iter_ref);
+        dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "(so)",
+                                          &iter_sub);
+        for (j = 0; j < i % 3; j++)
+          {
+            dbus_message_iter_open_container (&iter_sub, DBUS_TYPE_STRUCT, NULL,
+                                              &iter_ref);
+            dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_STRING, &name);
+            dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_OBJECT_PATH, &p);
+            dbus_message_iter_close_container (&iter_sub, &iter_ref);
+          }
+        dbus_message_iter_close_container (&iter_struct, &iter_sub);
+        dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "s",
+                                          &iter_sub);
+        for (j = 0; j < (i % 2) + 1; j++)
+            dbus_message_iter_append_basic (&iter_sub, DBUS_TYPE_STRING,
+                                            &wire_interfaces[j]);
+        dbus_message_iter_close_container (&iter_struct, &iter_sub);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT32, &role);
+        dbus_message_iter_close_container (&iter_array, &iter_struct);
+      }
+    dbus_message_iter_close_container (&iter, &iter_array);
+    return reply;
+}
+
+static DBusMessage *
+build_wire_reply (DBusMessage *call, guint n_items)
+{
+    DRouteWire *wire;
+    const gchar *name = ":1.42";
+    gchar path[64];
+    gsize array, sub;
+    guint i, j;
+
+    wire = droute_wire_new_reply (call, "a((so)a(so)asu)", n_items * 128);
+    array = droute_wire_open_array (wire, 8);
+    for (i = 0; i < n_items; i++)
+      {
+        g_snprintf (path, sizeof (path), "/org/a11y/atspi/accessible/%u", i);
+        droute_wire_open_struct (wire);
+        droute_wire_open_struct (wire);
+        droute_wire_append_string (wire, name);
+        droute_wire_append_string (wire, path);
+        sub = droute_wire_open_array (wire, 8);
+        for (j = 0; j < i % 3; j++)
+          {
+            droute_wire_open_struct (wire);
+            droute_wire_append_string (wire, name);
+            droute_wire_append_string (wire, path);
+          }
+        droute_wire_close_array (wire, sub);
+        sub = droute_wire_open_array (wire, 4);
+        for (j = 0; j < (i % 2) + 1; j++)
+            droute_wire_append_string (wire, wire_interfaces[j]);
+        droute_wire_close_array (wire, sub);
+        droute_wire_append_uint32 (wire, i % 100);
+      }
+    droute_wire_close_array (wire, array);
+    return droute_wire_finish (wire);
+}
+
+/*
+ * Times building the same reply both ways. droute-test checks that the
+ * two give the same bytes. Returns FALSE if libdbus rejects the wire.
+ */
+static gboolean
+run_wire (void)
+{
+    DBusMessage *call, *iter_reply, *wire_reply;
+    gint64 start, iter_time, wire_time;
+
+    call = dbus_message_new_method_call ("org.a11y.atspi.Bench",
+                                         BENCH_OBJECT_PATH, BENCH_CONTROL_IFACE,
+                                         "GetItems");
+    dbus_message_set_sender (call, ":1.7");
+    dbus_message_set_serial (call, 99);
+
+    start = g_get_monotonic_time ();
+    iter_reply = build_iter_reply (call, n_wire_items);
+    iter_time = g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    wire_reply = build_wire_reply (call, n_wire_items);
+    wire_time = g_get_monotonic_time () - start;
+
+    dbus_message_unref (iter_reply);
+    dbus_message_unref (call);
+    if (!wire_reply)
+      {
+        g_print ("Failed: libdbus rejected the DRouteWire reply\n");
+        return FALSE;
+      }
+    dbus_message_unref (wire_reply);
+
+    g_print ("\n%d item reply: DBusMessageIter %" G_GINT64_FORMAT " us, "
+             "DRouteWire %" G_GINT64_FORMAT " us\n",
+             n_wire_items, iter_time, wire_time);
+    return TRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main (int argc, char **argv)
+{
+    GOptionContext *options;
+    GError *err = NULL;
+    DBusConnection *bus;
+    DBusError error;
+    GString *address;
+    guint weights[BENCH_N_KINDS];
+    guint failures;
+    int fds[2], status;
+    pid_t server;
+    char c;
+
+    options = g_option_context_new ("- benchmark droute dispatch");
+    g_option_context_add_main_entries (options, entries, NULL);
+    if (!g_option_context_parse (options, &argc, &argv, &err))
+      {
+        g_printerr ("droute-bench: %s\n", err->message);
+        return 1;
+      }
+    g_option_context_free (options);
+
+    if (n_paths < 1 || n_interfaces < 1 || n_calls < 1 || n_warmup < 0 ||
+        n_lookups < 0 || n_wire_items < 0 || !parse_mix (mix, weights))
+      {
+        g_printerr ("droute-bench: bad arguments\n");
+        return 1;
+      }
+
+    if (pipe (fds) < 0)
+        return 1;
+
+    server = fork ();
+    if (server < 0)
+        return 1;
+    if (server == 0)
+      {
+        close (fds[0]);
+        run_server (fds[1]);
+      }
+    close (fds[1]);
+
+    address = g_string_new (NULL);
+    while (read (fds[0], &c, 1) == 1 && c)
+        g_string_append_c (address, c);
+    close (fds[0]);
+
+    dbus_error_init (&error);
+    bus = dbus_connection_open_private (address->str, &error);
+    g_string_free (address, TRUE);
+    if (!bus)
+      {
+        g_printerr ("droute-bench: %s\n", error.message);
+        dbus_error_free (&error);
+        kill (server, SIGTERM);
+        waitpid (server, NULL, 0);
+        return 1;
+      }
+
+    failures = run_client (bus);
+
+    dbus_connection_close (bus);
+    dbus_connection_unref (bus);
+    waitpid (server, &status, 0);
+
+    if (failures)
+      {
+        g_print ("Failed: %u calls returned an error\n", failures);
+        return 1;
+      }
+
+    if (n_lookups && !run_lookups ())
+        return 1;
+    if (n_wire_items && !run_wire ())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include <string.h>
+
+#include "droute-pending.h"
+
+struct _DRoutePendingReply
+{
+    DBusConnection      *bus;
+    DBusMessage         *message;
+    DRouteSliceFunction  func;
+    void                *data;
+    GDestroyNotify       destroy;
+    guint                idle_id;
+    gboolean             completed;
+    /* Set when captured, see droute_pending_capture_begin */
+    gboolean             captured;
+    DBusMessage         *reply;
+};
+
+/* All replies that are still being computed */
+static GList *pending_replies = NULL;
+
+static gboolean capturing = FALSE;
+static DRoutePendingReply *captured = NULL;
+
+/*---------------------------------------------------------------------------*/
+
+static void
+pending_reply_free (DRoutePendingReply *pending)
+{
+    pending_replies = g_list_remove (pending_replies, pending);
+
+    if (pending->idle_id)
+        g_source_remove (pending->idle_id);
+    if (pending->destroy)
+        (pending->destroy) (pending->data);
+    if (pending->reply)
+        dbus_message_unref (pending->reply);
+    dbus_message_unref (pending->message);
+    dbus_connection_unref (pending->bus);
+    g_free (pending);
+}
+
+static gboolean
+pending_reply_slice (gpointer user_data)
+{
+    DRoutePendingReply *pending = (DRoutePendingReply *) user_data;
+    gint64 deadline = g_get_monotonic_time () + DROUTE_SLICE_BUDGET_US;
+
+    /* Nobody is left to read the reply of a closed peer connection */
+    if (!dbus_connection_get_is_connected (pending->bus))
+      {
+        pending->idle_id = 0;
+        pending_reply_free (pending);
+        return FALSE;
+      }
+
+    if (!(pending->func) (pending, deadline, pending->data))
+        return TRUE;
+
+    if (!pending->completed)
+      {
+        DBusMessage *reply;
+
+        reply = dbus_message_new_error (pending->message, DBUS_ERROR_FAILED,
+                                        "Pending reply was never completed");
+        droute_pending_reply_complete (pending, reply);
+      }
+
+    pending->idle_id = 0;
+    pending_reply_free (pending);
+    return FALSE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+DRoutePendingReply *
+droute_pending_reply_new (DBusConnection      *bus,
+                          DBusMessage         *message,
+                          DRouteSliceFunction  func,
+                          void                *data,
+                          GDestroyNotify       destroy)
+{
+    DRoutePendingReply *pending;
+
+    pending = g_new0 (DRoutePendingReply, 1);
+    pending->bus = dbus_connection_ref (bus);
+    pending->message = dbus_message_ref (message);
+    pending->func = func;
+    pending->data = data;
+    pending->destroy = destroy;
+    if (capturing && !captured)
+      {
+        pending->captured = TRUE;
+        captured = pending;
+      }
+    else
+        pending->idle_id = g_idle_add (pending_reply_slice, pending);
+
+    pending_replies = g_list_prepend (pending_replies, pending);
+    return pending;
+}
+
+DBusMessage *
+droute_pending_reply_get_message (DRoutePendingReply *pending)
+{
+    return pending->message;
+}
+
+/*
+ * Sends the reply to the caller, taking ownership of it.
+ */
+void
+droute_pending_reply_complete (DRoutePendingReply *pending,
+                               DBusMessage        *reply)
+{
+    g_return_if_fail (!pending->completed);
+
+    pending->completed = TRUE;
+    if (pending->captured)
+        pending->reply = reply;
+    else if (reply)
+      {
+        dbus_connection_send (pending->bus, reply, NULL);
+        dbus_message_unref (reply);
+      }
+}
+
+/*
+ * Abandons all replies owed to a bus name that has left the bus.
+ */
+void
+droute_cancel_pending_replies (const char *sender)
+{
+    GList *l, *next;
+
+    for (l = pending_replies; l; l = next)
+      {
+        DRoutePendingReply *pending = l->data;
+
+        next = l->next;
+        if (!g_strcmp0 (dbus_message_get_sender (pending->message), sender))
+            pending_reply_free (pending);
+      }
+}
+
+/*---------------------------------------------------------------------------*/
+
+void
+droute_pending_capture_begin (void)
+{
+    capturing = TRUE;
+}
+
+DBusMessage *
+droute_pending_capture_end (void)
+{
+    DRoutePendingReply *pending = captured;
+    DBusMessage *reply;
+
+    capturing = FALSE;
+    captured = NULL;
+    if (!pending)
+        return NULL;
+
+    while (!(pending->func) (pending, G_MAXINT64, pending->data))
+        ;
+    if (!pending->completed)
+        droute_pending_reply_complete (pending,
+                                       dbus_message_new_error (pending->message,
+                                                               DBUS_ERROR_FAILED,
+                                                               "Pending reply was never completed"));
+
+    reply = pending->reply;
+    pending->reply = NULL;
+    pending_reply_free (pending);
+    return reply;
+}
+
+/*END------------------------------------------------------------------------*/
@@ -0,0 +1,74 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+#ifndef _DROUTE_PENDING_H
+#define _DROUTE_PENDING_H
+
+#include <dbus/dbus.h>
+#include <glib.h>
+
+/*
+ * A pending reply lets a DRouteFunction answer its method call later.
+ *
+ * The handler creates the pending reply with a slice function and
+ * returns NULL. The slice function is then called from idle callbacks,
+ * each call being given a deadline it should return by. It returns TRUE
+ * once it has called droute_pending_reply_complete, or FALSE to be
+ * called again in a later main loop iteration.
+ */
+
+typedef struct _DRoutePendingReply DRoutePendingReply;
+
+typedef gboolean (*DRouteSliceFunction) (DRoutePendingReply *pending,
+                                         gint64              deadline,
+                                         void               *data);
+
+/* Time budget per slice, in microseconds */
+#define DROUTE_SLICE_BUDGET_US (5000)
+
+DRoutePendingReply *
+droute_pending_reply_new      (DBusConnection      *bus,
+                               DBusMessage         *message,
+                               DRouteSliceFunction  func,
+                               void                *data,
+                               GDestroyNotify       destroy);
+
+DBusMessage *
+droute_pending_reply_get_message (DRoutePendingReply *pending);
+
+void
+droute_pending_reply_complete (DRoutePendingReply *pending,
+                               DBusMessage        *reply);
+
+void
+droute_cancel_pending_replies (const char *sender);
+
+/*
+ * Used by the batch interface. A pending reply created between the two
+ * calls is not scheduled. droute_pending_capture_end runs it to
+ * completion and returns its reply rather than sending it, or returns
+ * NULL if none was created.
+ */
+void
+droute_pending_capture_begin (void);
+
+DBusMessage *
+droute_pending_capture_end (void);
+
+#endif /* _DROUTE_PENDING_H */
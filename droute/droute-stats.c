@@ -0,0 +1,240 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string.h>
+
+#include "droute-stats.h"
+#include "droute-pairhash.h"
+
+typedef struct _DRouteStatsEntry
+{
+    StrPair  key;
+    guint64  count;
+    guint64  total;
+    guint64  max;
+    guint64  buckets[DROUTE_STATS_BUCKETS];
+} DRouteStatsEntry;
+
+struct _DRouteStats
+{
+    GHashTable *entries;
+};
+
+/*---------------------------------------------------------------------------*/
+
+static void
+entry_free (DRouteStatsEntry *entry)
+{
+    g_free ((gchar *) entry->key.one);
+    g_free ((gchar *) entry->key.two);
+    g_free (entry);
+}
+
+/* Bucket i holds latencies below 2^i microseconds */
+static guint
+entry_bucket (guint64 elapsed)
+{
+    guint bucket = 0;
+
+    while (elapsed && bucket < DROUTE_STATS_BUCKETS - 1)
+      {
+        elapsed >>= 1;
+        bucket++;
+      }
+    return bucket;
+}
+
+static guint64
+entry_percentile (DRouteStatsEntry *entry, guint percent)
+{
+    guint64 wanted;
+    guint64 seen = 0;
+    guint i;
+
+    if (!entry->count)
+        return 0;
+
+    wanted = (entry->count * percent + 99) / 100;
+    for (i = 0; i < DROUTE_STATS_BUCKETS; i++)
+      {
+        seen += entry->buckets[i];
+        if (seen >= wanted)
+            return MIN (((guint64) 1 << i) - 1, entry->max);
+      }
+    return entry->max;
+}
+
+static gint
+entry_compare (gconstpointer a, gconstpointer b)
+{
+    const DRouteStatsEntry *ea = *(const DRouteStatsEntry **) a;
+    const DRouteStatsEntry *eb = *(const DRouteStatsEntry **) b;
+    gint result;
+
+    result = strcmp (ea->key.one, eb->key.one);
+    if (!result)
+        result = strcmp (ea->key.two, eb->key.two);
+    return result;
+}
+
+/* Returns the entries in a stable order, for reporting */
+static GPtrArray *
+stats_sorted_entries (DRouteStats *stats)
+{
+    GPtrArray *entries;
+    GHashTableIter iter;
+    gpointer value;
+
+    entries = g_ptr_array_sized_new (g_hash_table_size (stats->entries));
+    g_hash_table_iter_init (&iter, stats->entries);
+    while (g_hash_table_iter_next (&iter, NULL, &value))
+        g_ptr_array_add (entries, value);
+    g_ptr_array_sort (entries, entry_compare);
+    return entries;
+}
+
+/*---------------------------------------------------------------------------*/
+
+DRouteStats *
+droute_stats_new (void)
+{
+    DRouteStats *stats;
+
+    stats = g_new0 (DRouteStats, 1);
+    stats->entries = g_hash_table_new_full (str_pair_hash, str_pair_equal,
+                                            NULL, (GDestroyNotify) entry_free);
+    return stats;
+}
+
+void
+droute_stats_free (DRouteStats *stats)
+{
+    g_hash_table_destroy (stats->entries);
+    g_free (stats);
+}
+
+void
+droute_stats_reset (DRouteStats *stats)
+{
+    g_hash_table_remove_all (stats->entries);
+}
+
+void
+droute_stats_record (DRouteStats *stats,
+                     const char  *iface,
+                     const char  *member,
+                     gint64       elapsed)
+{
+    DRouteStatsEntry *entry;
+    StrPair key;
+
+    key.one = iface;
+    key.two = member;
+    entry = g_hash_table_lookup (stats->entries, &key);
+    if (!entry)
+      {
+        entry = g_new0 (DRouteStatsEntry, 1);
+        entry->key.one = g_strdup (iface);
+        entry->key.two = g_strdup (member);
+        g_hash_table_insert (stats->entries, &entry->key, entry);
+      }
+
+    if (elapsed < 0)
+        elapsed = 0;
+    entry->count++;
+    entry->total += elapsed;
+    if ((guint64) elapsed > entry->max)
+        entry->max = elapsed;
+    entry->buckets[entry_bucket (elapsed)]++;
+}
+
+/*
+ * Appends an array of DROUTE_STATS_SIGNATURE structures to iter.
+ */
+void
+droute_stats_append (DRouteStats *stats, DBusMessageIter *iter)
+{
+    DBusMessageIter iter_array, iter_struct;
+    GPtrArray *entries;
+    guint i;
+
+    entries = stats_sorted_entries (stats);
+    dbus_message_iter_open_container (iter, DBUS_TYPE_ARRAY,
+                                      DROUTE_STATS_SIGNATURE, &iter_array);
+    for (i = 0; i < entries->len; i++)
+      {
+        DRouteStatsEntry *entry = g_ptr_array_index (entries, i);
+        dbus_uint64_t p50 = entry_percentile (entry, 50);
+        dbus_uint64_t p99 = entry_percentile (entry, 99);
+
+        dbus_message_iter_open_container (&iter_array, DBUS_TYPE_STRUCT, NULL,
+                                          &iter_struct);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING,
+                                        &entry->key.one);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING,
+                                        &entry->key.two);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64,
+                                        &entry->count);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64,
+                                        &entry->total);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64, &p50);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64, &p99);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT64,
+                                        &entry->max);
+        dbus_message_iter_close_container (&iter_array, &iter_struct);
+      }
+    dbus_message_iter_close_container (iter, &iter_array);
+    g_ptr_array_free (entries, TRUE);
+}
+
+/*
+ * Formats the statistics as a whitespace separated table, led by a
+ * comment naming the columns.
+ */
+gchar *
+droute_stats_format (DRouteStats *stats)
+{
+    GString *out;
+    GPtrArray *entries;
+    guint i;
+
+    entries = stats_sorted_entries (stats);
+    out = g_string_new ("# interface member calls total_us p50_us p99_us max_us\n");
+    for (i = 0; i < entries->len; i++)
+      {
+        DRouteStatsEntry *entry = g_ptr_array_index (entries, i);
+
+        g_string_append_printf (out,
+                                "%s %s %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT
+                                " %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT
+                                " %" G_GUINT64_FORMAT "\n",
+                                entry->key.one, entry->key.two,
+                                entry->count, entry->total,
+                                entry_percentile (entry, 50),
+                                entry_percentile (entry, 99),
+                                entry->max);
+      }
+    g_ptr_array_free (entries, TRUE);
+
+    return g_string_free (out, FALSE);
+}
+
+/*END------------------------------------------------------------------------*/
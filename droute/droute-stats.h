@@ -0,0 +1,69 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+#ifndef _DROUTE_STATS_H
+#define _DROUTE_STATS_H
+
+#include <dbus/dbus.h>
+#include <glib.h>
+
+/*
+ * Call counts and latency histograms, kept per (interface, member).
+ *
+ * Latencies are bucketed by powers of two microseconds, so recording a
+ * call never allocates once its (interface, member) has been seen.
+ * Percentiles are reported as the upper bound of the bucket they fall
+ * in. Time spent resolving object paths with path_get_datum is kept
+ * under the DROUTE_STATS_DATUM interface, one entry per registered path.
+ */
+
+typedef struct _DRouteStats DRouteStats;
+
+#define DROUTE_STATS_BUCKETS (32)
+
+#define DROUTE_STATS_DATUM "(datum)"
+
+/* Signature of one element of org.a11y.atspi.Stats.GetStats:
+ * interface, member, calls, total, p50, p99 and max, times in microseconds.
+ */
+#define DROUTE_STATS_SIGNATURE "(ssttttt)"
+
+DRouteStats *
+droute_stats_new    (void);
+
+void
+droute_stats_free   (DRouteStats *stats);
+
+void
+droute_stats_reset  (DRouteStats *stats);
+
+void
+droute_stats_record (DRouteStats *stats,
+                     const char  *iface,
+                     const char  *member,
+                     gint64       elapsed);
+
+void
+droute_stats_append (DRouteStats     *stats,
+                     DBusMessageIter *iter);
+
+gchar *
+droute_stats_format (DRouteStats  *stats);
+
+#endif /* _DROUTE_STATS_H */
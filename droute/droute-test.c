@@ -7,6 +7,8 @@
 #include "atspi/atspi.h"
 
 #define TEST_OBJECT_PATH    "/test/object"
+#define TEST_BATCH_PATH     "/test/batch"
+#define TEST_STATS_PATH     "/test/stats"
 #define TEST_INTERFACE_ONE  "test.interface.One"
 #define TEST_INTERFACE_TWO  "test.interface.Two"
 
@@ -21,6 +23,8 @@
 
 #define NONE_REPLY_STRING "NoneMethod"
 
+#define TEST_WIRE_ITEMS 64
+
 const gchar *test_interface_One = \
 "<interface name=\"test.interface.One\">"
 "  <method name=\"null\"/>"
@@ -62,6 +66,8 @@ typedef struct _AnObject
 } AnObject;
 
 static DBusConnection *bus;
+static DRoutePath     *test_path;
+static DRouteContext  *test_context;
 static GMainLoop      *main_loop;
 static gboolean       success = TRUE;
 
@@ -161,13 +167,38 @@ impl_getInterfaceTwo (DBusConnection *bus, DBusMessage *message, void *user_data
     return reply;
 }
 
+/* Replies through a pending reply, on the second slice */
+static gboolean
+later_slice (DRoutePendingReply *pending, gint64 deadline, void *data)
+{
+    gint *slices = (gint *) data;
+    DBusMessage *reply;
+    gchar *itf = TEST_INTERFACE_ONE;
+
+    if (++(*slices) < 2)
+        return FALSE;
+
+    reply = dbus_message_new_method_return (droute_pending_reply_get_message (pending));
+    dbus_message_append_args (reply, DBUS_TYPE_STRING, &itf, DBUS_TYPE_INVALID);
+    droute_pending_reply_complete (pending, reply);
+    return TRUE;
+}
+
+static DBusMessage *
+impl_getInterfaceOneLater (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    droute_pending_reply_new (bus, message, later_slice, g_new0 (gint, 1), g_free);
+    return NULL;
+}
+
 static DRouteMethod test_methods_one[] = {
     {impl_null,            "null"},
     {impl_getInt,          "getInt"},
     {impl_setInt,          "setInt"},
     {impl_getString,       "getString"},
     {impl_setString,       "setString"},
-    {impl_getInterfaceOne, "getInterfaceOne"},
+    {impl_getInterfaceOne, "getInterfaceOne", ""},
+    {impl_getInterfaceOneLater, "getInterfaceOneLater", ""},
     {NULL, NULL}
 };
 
@@ -185,6 +216,13 @@ static DRouteProperty test_properties[] = {
     {NULL, NULL, NULL}
 };
 
+static void
+count_call (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    if (!g_strcmp0 (dbus_message_get_member (message), "getInterfaceOne"))
+        (*(gint *) user_data)++;
+}
+
 static void
 set_reply (DBusPendingCall *pending, void *user_data)
 {
@@ -212,6 +250,158 @@ send_and_allow_reentry (DBusConnection *bus, DBusMessage *message, DBusError *er
     return reply;
 }
 
+/*
+ * Checks that every method of both interfaces is found through the
+ * dispatch tables, and that unknown members and interfaces are not.
+ * droute-bench times the lookups.
+ */
+static void
+test_dispatch (void)
+{
+    static const DRouteMethod *tables[] = { test_methods_one, test_methods_two };
+    static const gchar *interfaces[] = { TEST_INTERFACE_ONE, TEST_INTERFACE_TWO };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (tables); i++)
+      {
+        const DRouteMethod *m;
+
+        for (m = tables[i]; m->name != NULL; m++)
+          {
+            /* A copy, so that the lookup cannot rely on pointer equality */
+            gchar *member = g_strdup (m->name);
+
+            if (droute_path_get_method (test_path, interfaces[i], member) !=
+                m->func)
+              {
+                g_print ("Failed: %s.%s was not dispatched to its method\n",
+                         interfaces[i], m->name);
+                exit (1);
+              }
+            g_free (member);
+          }
+      }
+
+    if (droute_path_get_method (test_path, TEST_INTERFACE_ONE, "noSuchMethod") ||
+        droute_path_get_method (test_path, "test.interface.None", "null"))
+      {
+        g_print ("Failed: an unknown method was dispatched\n");
+        exit (1);
+      }
+}
+
+/*
+ * Builds the same reply of TEST_WIRE_ITEMS cache-like items through
+ * DBusMessageIter and through DRouteWire, and checks that both marshal
+ * to the same bytes. droute-bench times the two.
+ */
+static void
+test_wire (void)
+{
+    static const gchar *itfs[] = { "org.a11y.atspi.Accessible",
+                                   "org.a11y.atspi.Component" };
+    DBusMessage *call, *iter_reply, *wire_reply;
+    DBusMessageIter iter, iter_array, iter_struct, iter_sub, iter_ref;
+    DRouteWire *wire;
+    gsize array, sub;
+    gchar *iter_data, *wire_data;
+    int iter_len, wire_len;
+    const gchar *name = ":1.42";
+    gchar path[64];
+    guint i, j;
+
+    call = dbus_message_new_method_call ("org.a11y.atspi.Test", TEST_OBJECT_PATH,
+                                         TEST_INTERFACE_ONE, "GetItems");
+    dbus_message_set_sender (call, ":1.7");
+    dbus_message_set_serial (call, 99);
+
+    iter_reply = dbus_message_new_method_return (call);
+    dbus_message_iter_init_append (iter_reply, &iter);
+    dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY, "((so)a(so)asu)",
+                                      &iter_array);
+    for (i = 0; i < TEST_WIRE_ITEMS; i++)
+      {
+        const gchar *p = path;
+        dbus_uint32_t role = i % 100;
+
+        g_snprintf (path, sizeof (path), "/org/a11y/atspi/accessible/%u", i);
+        dbus_message_iter_open_container (&iter_array, DBUS_TYPE_STRUCT, NULL,
+                                          &iter_struct);
+        dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_STRUCT, NULL,
+                                          &iter_ref);
+        dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_STRING, &name);
+        dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_OBJECT_PATH, &p);
+        dbus_message_iter_close_container (&iter_struct, &iter_ref);
+        dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "(so)",
+                                          &iter_sub);
+        for (j = 0; j < i % 3; j++)
+          {
+            dbus_message_iter_open_container (&iter_sub, DBUS_TYPE_STRUCT, NULL,
+                                              &iter_ref);
+            dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_STRING, &name);
+            dbus_message_iter_append_basic (&iter_ref, DBUS_TYPE_OBJECT_PATH, &p);
+            dbus_message_iter_close_container (&iter_sub, &iter_ref);
+          }
+        dbus_message_iter_close_container (&iter_struct, &iter_sub);
+        dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "s",
+                                          &iter_sub);
+        for (j = 0; j < (i % 2) + 1; j++)
+            dbus_message_iter_append_basic (&iter_sub, DBUS_TYPE_STRING, &itfs[j]);
+        dbus_message_iter_close_container (&iter_struct, &iter_sub);
+        dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_UINT32, &role);
+        dbus_message_iter_close_container (&iter_array, &iter_struct);
+      }
+    dbus_message_iter_close_container (&iter, &iter_array);
+
+    wire = droute_wire_new_reply (call, "a((so)a(so)asu)", TEST_WIRE_ITEMS * 128);
+    array = droute_wire_open_array (wire, 8);
+    for (i = 0; i < TEST_WIRE_ITEMS; i++)
+      {
+        g_snprintf (path, sizeof (path), "/org/a11y/atspi/accessible/%u", i);
+        droute_wire_open_struct (wire);
+        droute_wire_open_struct (wire);
+        droute_wire_append_string (wire, name);
+        droute_wire_append_string (wire, path);
+        sub = droute_wire_open_array (wire, 8);
+        for (j = 0; j < i % 3; j++)
+          {
+            droute_wire_open_struct (wire);
+            droute_wire_append_string (wire, name);
+            droute_wire_append_string (wire, path);
+          }
+        droute_wire_close_array (wire, sub);
+        sub = droute_wire_open_array (wire, 4);
+        for (j = 0; j < (i % 2) + 1; j++)
+            droute_wire_append_string (wire, itfs[j]);
+        droute_wire_close_array (wire, sub);
+        droute_wire_append_uint32 (wire, i % 100);
+      }
+    droute_wire_close_array (wire, array);
+    wire_reply = droute_wire_finish (wire);
+
+    if (!wire_reply)
+      {
+        g_print ("Failed: libdbus rejected the DRouteWire reply\n");
+        exit (1);
+      }
+
+    dbus_message_set_serial (iter_reply, 1);
+    dbus_message_set_serial (wire_reply, 1);
+    dbus_message_marshal (iter_reply, &iter_data, &iter_len);
+    dbus_message_marshal (wire_reply, &wire_data, &wire_len);
+    if (iter_len != wire_len || memcmp (iter_data, wire_data, iter_len))
+      {
+        g_print ("Failed: DRouteWire reply differs from the iterator one\n");
+        exit (1);
+      }
+
+    dbus_free (iter_data);
+    dbus_free (wire_data);
+    dbus_message_unref (wire_reply);
+    dbus_message_unref (iter_reply);
+    dbus_message_unref (call);
+}
+
 gboolean
 do_tests_func (gpointer data)
 {
@@ -258,6 +448,233 @@ do_tests_func (gpointer data)
 
     /* --------------------------------------------------------*/
 
+    {
+      dbus_int32_t extra = 1;
+
+      message = dbus_message_new_method_call (bus_name,
+                                              TEST_OBJECT_PATH,
+                                              TEST_INTERFACE_ONE,
+                                              "getInterfaceOne");
+      dbus_message_append_args (message, DBUS_TYPE_INT32, &extra,
+                                DBUS_TYPE_INVALID);
+      reply = send_and_allow_reentry (bus, message, NULL);
+      dbus_message_unref (message);
+      if (!reply || dbus_message_get_type (reply) != DBUS_MESSAGE_TYPE_ERROR)
+        {
+          g_print ("Failed: getInterfaceOne accepted an unexpected argument\n");
+          exit (1);
+        }
+      dbus_message_unref (reply);
+    }
+
+    /* --------------------------------------------------------*/
+
+    {
+      static const gchar *members[] = { "getInterfaceOne", "noSuchMethod", "",
+                                        "getInterfaceOneLater" };
+      DBusMessageIter iter, iter_array, iter_struct, iter_args;
+      const gchar *path = TEST_OBJECT_PATH;
+      const gchar *itf = TEST_INTERFACE_ONE;
+      const gchar *error_name;
+      gint i;
+
+      message = dbus_message_new_method_call (bus_name,
+                                              TEST_BATCH_PATH,
+                                              DROUTE_BATCH_INTERFACE,
+                                              "Call");
+      dbus_message_iter_init_append (message, &iter);
+      dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY, "(ossav)",
+                                        &iter_array);
+      for (i = 0; i < G_N_ELEMENTS (members); i++)
+        {
+          dbus_message_iter_open_container (&iter_array, DBUS_TYPE_STRUCT, NULL,
+                                            &iter_struct);
+          dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_OBJECT_PATH, &path);
+          dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &itf);
+          dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &members[i]);
+          dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "v",
+                                            &iter_args);
+          dbus_message_iter_close_container (&iter_struct, &iter_args);
+          dbus_message_iter_close_container (&iter_array, &iter_struct);
+        }
+      dbus_message_iter_close_container (&iter, &iter_array);
+      reply = send_and_allow_reentry (bus, message, NULL);
+      dbus_message_unref (message);
+
+      if (!reply || strcmp (dbus_message_get_signature (reply), "a(sav)") != 0)
+        {
+          g_print ("Failed: Batch.Call returned an unexpected reply\n");
+          exit (1);
+        }
+
+      dbus_message_iter_init (reply, &iter);
+      dbus_message_iter_recurse (&iter, &iter_array);
+      dbus_message_iter_recurse (&iter_array, &iter_struct);
+      dbus_message_iter_get_basic (&iter_struct, &error_name);
+      dbus_message_iter_next (&iter_struct);
+      dbus_message_iter_recurse (&iter_struct, &iter_args);
+      dbus_message_iter_recurse (&iter_args, &iter_struct);
+      dbus_message_iter_get_basic (&iter_struct, &result_string);
+      if (error_name[0] != '\0' || g_strcmp0 (result_string, TEST_INTERFACE_ONE))
+        {
+          g_print ("Failed: batched getInterfaceOne returned '%s' '%s'\n",
+                   error_name, result_string);
+          exit (1);
+        }
+
+      dbus_message_iter_next (&iter_array);
+      dbus_message_iter_recurse (&iter_array, &iter_struct);
+      dbus_message_iter_get_basic (&iter_struct, &error_name);
+      if (error_name[0] == '\0')
+        {
+          g_print ("Failed: batched call to an unknown method succeeded\n");
+          exit (1);
+        }
+
+      dbus_message_iter_next (&iter_array);
+      dbus_message_iter_recurse (&iter_array, &iter_struct);
+      dbus_message_iter_get_basic (&iter_struct, &error_name);
+      if (g_strcmp0 (error_name, DBUS_ERROR_INVALID_ARGS))
+        {
+          g_print ("Failed: batched call with an invalid member returned '%s'\n",
+                   error_name);
+          exit (1);
+        }
+
+      /* A deferred reply is captured into the batch */
+      dbus_message_iter_next (&iter_array);
+      dbus_message_iter_recurse (&iter_array, &iter_struct);
+      dbus_message_iter_get_basic (&iter_struct, &error_name);
+      dbus_message_iter_next (&iter_struct);
+      dbus_message_iter_recurse (&iter_struct, &iter_args);
+      dbus_message_iter_recurse (&iter_args, &iter_struct);
+      dbus_message_iter_get_basic (&iter_struct, &result_string);
+      if (error_name[0] != '\0' || g_strcmp0 (result_string, TEST_INTERFACE_ONE))
+        {
+          g_print ("Failed: batched getInterfaceOneLater returned '%s' '%s'\n",
+                   error_name, result_string);
+          exit (1);
+        }
+      dbus_message_unref (reply);
+    }
+
+    /* --------------------------------------------------------*/
+
+    {
+      DBusMessageIter iter, iter_array, iter_struct;
+      dbus_uint64_t count = 0;
+      gint i;
+
+      droute_context_set_stats_enabled (test_context, TRUE);
+      for (i = 0; i < 2; i++)
+        {
+          message = dbus_message_new_method_call (bus_name,
+                                                  TEST_OBJECT_PATH,
+                                                  TEST_INTERFACE_ONE,
+                                                  "getInterfaceOne");
+          reply = send_and_allow_reentry (bus, message, NULL);
+          dbus_message_unref (message);
+          if (reply)
+            dbus_message_unref (reply);
+        }
+
+      message = dbus_message_new_method_call (bus_name,
+                                              TEST_STATS_PATH,
+                                              DROUTE_STATS_INTERFACE,
+                                              "GetStats");
+      reply = send_and_allow_reentry (bus, message, NULL);
+      dbus_message_unref (message);
+      if (!reply || strcmp (dbus_message_get_signature (reply),
+                            "a" DROUTE_STATS_SIGNATURE) != 0)
+        {
+          g_print ("Failed: Stats.GetStats returned an unexpected reply\n");
+          exit (1);
+        }
+
+      dbus_message_iter_init (reply, &iter);
+      dbus_message_iter_recurse (&iter, &iter_array);
+      while (dbus_message_iter_get_arg_type (&iter_array) != DBUS_TYPE_INVALID)
+        {
+          const gchar *itf, *member;
+
+          dbus_message_iter_recurse (&iter_array, &iter_struct);
+          dbus_message_iter_get_basic (&iter_struct, &itf);
+          dbus_message_iter_next (&iter_struct);
+          dbus_message_iter_get_basic (&iter_struct, &member);
+          dbus_message_iter_next (&iter_struct);
+          if (!strcmp (itf, TEST_INTERFACE_ONE) && !strcmp (member, "getInterfaceOne"))
+            dbus_message_iter_get_basic (&iter_struct, &count);
+          dbus_message_iter_next (&iter_array);
+        }
+      dbus_message_unref (reply);
+      droute_context_set_stats_enabled (test_context, FALSE);
+
+      if (count != 2)
+        {
+          g_print ("Failed: getInterfaceOne was counted %u times; expected 2\n",
+                   (guint) count);
+          exit (1);
+        }
+    }
+
+    /* --------------------------------------------------------*/
+
+    {
+      dbus_bool_t enabled = FALSE;
+
+      /* Turning statistics off is itself a call being timed */
+      droute_context_set_stats_enabled (test_context, TRUE);
+      message = dbus_message_new_method_call (bus_name,
+                                              TEST_STATS_PATH,
+                                              DROUTE_STATS_INTERFACE,
+                                              "SetEnabled");
+      dbus_message_append_args (message, DBUS_TYPE_BOOLEAN, &enabled,
+                                DBUS_TYPE_INVALID);
+      reply = send_and_allow_reentry (bus, message, NULL);
+      dbus_message_unref (message);
+      if (!reply || dbus_message_get_type (reply) != DBUS_MESSAGE_TYPE_METHOD_RETURN ||
+          droute_context_get_stats (test_context) != NULL)
+        {
+          g_print ("Failed: Stats.SetEnabled(false) did not turn statistics off\n");
+          exit (1);
+        }
+      dbus_message_unref (reply);
+    }
+
+    /* --------------------------------------------------------*/
+
+    {
+      gint calls = 0;
+
+      droute_context_set_call_observer (test_context, count_call, &calls);
+      message = dbus_message_new_method_call (bus_name,
+                                              TEST_OBJECT_PATH,
+                                              TEST_INTERFACE_ONE,
+                                              "getInterfaceOne");
+      reply = send_and_allow_reentry (bus, message, NULL);
+      dbus_message_unref (message);
+      if (reply)
+        dbus_message_unref (reply);
+      droute_context_set_call_observer (test_context, NULL, NULL);
+
+      if (calls != 1)
+        {
+          g_print ("Failed: the call observer saw %d calls; expected 1\n",
+                   calls);
+          exit (1);
+        }
+    }
+
+    /* --------------------------------------------------------*/
+
+    test_dispatch ();
+
+    /* --------------------------------------------------------*/
+
+    test_wire ();
+
+    /* --------------------------------------------------------*/
+
 out:
     g_main_loop_quit (main_loop);
     return FALSE;
@@ -283,7 +700,9 @@ int main (int argc, char **argv)
     atspi_dbus_connection_setup_with_g_main(bus, g_main_context_default());
 
     cnx = droute_new ();
+    test_context = cnx;
     path = droute_add_one (cnx, TEST_OBJECT_PATH, object);
+    test_path = path;
 
     droute_path_add_interface (path,
                                TEST_INTERFACE_ONE,
@@ -297,7 +716,10 @@ int main (int argc, char **argv)
                                test_methods_two,
                                test_properties);
 
-    droute_path_register (path, bus);
+    droute_add_batch (cnx, TEST_BATCH_PATH);
+    droute_add_stats (cnx, TEST_STATS_PATH);
+
+    droute_context_register (cnx, bus);
 
     g_idle_add (do_tests_func, NULL);
     g_main_loop_run(main_loop);
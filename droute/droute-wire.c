@@ -0,0 +1,226 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string.h>
+
+#include "droute-wire.h"
+
+struct _DRouteWire
+{
+    GByteArray *data;
+    gsize       body_start;
+};
+
+/* Offset of the body length within the fixed part of the header */
+#define WIRE_BODY_LENGTH_OFFSET (4)
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Pads with zero bytes to the given alignment. The body starts on an
+ * eight byte boundary, so aligning against the start of the buffer is
+ * the same as aligning against the start of the body.
+ */
+static void
+wire_align (DRouteWire *wire, guint alignment)
+{
+    static const guint8 zeroes[8] = { 0 };
+    gsize padding = (alignment - (wire->data->len % alignment)) % alignment;
+
+    if (padding)
+        g_byte_array_append (wire->data, zeroes, padding);
+}
+
+static void
+wire_append_byte (DRouteWire *wire, guint8 value)
+{
+    g_byte_array_append (wire->data, &value, 1);
+}
+
+static void
+wire_set_uint32 (DRouteWire *wire, gsize offset, dbus_uint32_t value)
+{
+    memcpy (wire->data->data + offset, &value, sizeof (value));
+}
+
+static void
+wire_append_signature (DRouteWire *wire, const char *signature)
+{
+    wire_append_byte (wire, strlen (signature));
+    g_byte_array_append (wire->data, (const guint8 *) signature,
+                         strlen (signature) + 1);
+}
+
+/* Starts a header field, a (yv) structure */
+static void
+wire_open_field (DRouteWire *wire, guint8 code, const char *type)
+{
+    wire_align (wire, 8);
+    wire_append_byte (wire, code);
+    wire_append_signature (wire, type);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Starts a reply to message whose body has the given signature.
+ * reserve is a guess at the size of the body, to avoid reallocations.
+ */
+DRouteWire *
+droute_wire_new_reply (DBusMessage *message,
+                       const char  *signature,
+                       gsize        reserve)
+{
+    DRouteWire *wire;
+    const char *sender = dbus_message_get_sender (message);
+    gsize fields;
+
+    wire = g_new0 (DRouteWire, 1);
+    wire->data = g_byte_array_sized_new (reserve + 128);
+
+    wire_append_byte (wire, G_BYTE_ORDER == G_LITTLE_ENDIAN ? 'l' : 'B');
+    wire_append_byte (wire, DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    wire_append_byte (wire, DBUS_HEADER_FLAG_NO_REPLY_EXPECTED);
+    wire_append_byte (wire, DBUS_MAJOR_PROTOCOL_VERSION);
+    droute_wire_append_uint32 (wire, 0);
+    /* A placeholder serial; droute_wire_finish clears it */
+    droute_wire_append_uint32 (wire, 1);
+
+    fields = droute_wire_open_array (wire, 8);
+
+    /* Same field order as libdbus, so the output is byte for byte
+     * what dbus_message_new_method_return would give.
+     */
+    if (sender)
+      {
+        wire_open_field (wire, DBUS_HEADER_FIELD_DESTINATION,
+                         DBUS_TYPE_STRING_AS_STRING);
+        droute_wire_append_string (wire, sender);
+      }
+
+    wire_open_field (wire, DBUS_HEADER_FIELD_REPLY_SERIAL,
+                     DBUS_TYPE_UINT32_AS_STRING);
+    droute_wire_append_uint32 (wire, dbus_message_get_serial (message));
+
+    wire_open_field (wire, DBUS_HEADER_FIELD_SIGNATURE,
+                     DBUS_TYPE_SIGNATURE_AS_STRING);
+    wire_append_signature (wire, signature);
+
+    droute_wire_close_array (wire, fields);
+    wire_align (wire, 8);
+    wire->body_start = wire->data->len;
+
+    return wire;
+}
+
+void
+droute_wire_free (DRouteWire *wire)
+{
+    g_byte_array_free (wire->data, TRUE);
+    g_free (wire);
+}
+
+void
+droute_wire_append_uint32 (DRouteWire *wire, dbus_uint32_t value)
+{
+    wire_align (wire, 4);
+    g_byte_array_append (wire->data, (const guint8 *) &value, sizeof (value));
+}
+
+void
+droute_wire_append_string (DRouteWire *wire, const char *value)
+{
+    dbus_uint32_t length = strlen (value);
+
+    droute_wire_append_uint32 (wire, length);
+    g_byte_array_append (wire->data, (const guint8 *) value, length + 1);
+}
+
+void
+droute_wire_open_struct (DRouteWire *wire)
+{
+    wire_align (wire, 8);
+}
+
+gsize
+droute_wire_open_array (DRouteWire *wire, guint element_alignment)
+{
+    gsize length_offset;
+    gsize padded;
+
+    droute_wire_append_uint32 (wire, 0);
+    length_offset = wire->data->len - 4;
+    wire_align (wire, element_alignment);
+
+    /* The padding before the first element is not counted in the
+     * length, so remember it in the length until the array is closed.
+     */
+    padded = wire->data->len - length_offset - 4;
+    wire_set_uint32 (wire, length_offset, padded);
+    return length_offset;
+}
+
+void
+droute_wire_close_array (DRouteWire *wire, gsize array)
+{
+    dbus_uint32_t padded;
+
+    memcpy (&padded, wire->data->data + array, sizeof (padded));
+    wire_set_uint32 (wire, array, wire->data->len - array - 4 - padded);
+}
+
+gsize
+droute_wire_get_size (DRouteWire *wire)
+{
+    return wire->data->len - wire->body_start;
+}
+
+/*
+ * Consumes wire, returning the finished reply, or NULL if libdbus
+ * does not accept what was written.
+ */
+DBusMessage *
+droute_wire_finish (DRouteWire *wire)
+{
+    DBusMessage *parsed, *reply = NULL;
+    DBusError error;
+
+    wire_set_uint32 (wire, WIRE_BODY_LENGTH_OFFSET, droute_wire_get_size (wire));
+
+    dbus_error_init (&error);
+    parsed = dbus_message_demarshal ((const char *) wire->data->data,
+                                     wire->data->len, &error);
+    if (parsed)
+      {
+        /* The copy has its serial cleared, so that the connection
+         * assigns one when it is sent.
+         */
+        reply = dbus_message_copy (parsed);
+        dbus_message_unref (parsed);
+      }
+    else
+        dbus_error_free (&error);
+
+    droute_wire_free (wire);
+    return reply;
+}
+
+/*END------------------------------------------------------------------------*/
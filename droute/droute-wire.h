@@ -0,0 +1,76 @@
+/*
+ * AT-SPI - Assistive Technology Service Provider Interface
+ * (Gnome Accessibility Project; http://developer.gnome.org/projects/gap)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _DROUTE_WIRE_H
+#define _DROUTE_WIRE_H
+
+#include <dbus/dbus.h>
+#include <glib.h>
+
+/*
+ * Writes a method return in D-Bus wire format directly into a buffer.
+ *
+ * Building a reply of many thousands of structures through
+ * DBusMessageIter costs several calls and checks per field. For replies
+ * of a fixed, known shape a DRouteWire can be used instead: the header
+ * is written up front, the body is appended field by field with only
+ * the alignment the wire format requires, and droute_wire_finish turns
+ * the buffer into a DBusMessage. libdbus validates the result there, so
+ * a NULL return means the caller should build the reply the usual way.
+ */
+
+typedef struct _DRouteWire DRouteWire;
+
+DRouteWire *
+droute_wire_new_reply     (DBusMessage *message,
+                           const char  *signature,
+                           gsize        reserve);
+
+void
+droute_wire_free          (DRouteWire *wire);
+
+void
+droute_wire_append_uint32 (DRouteWire   *wire,
+                           dbus_uint32_t value);
+
+/* Strings and object paths share a wire representation */
+void
+droute_wire_append_string (DRouteWire *wire,
+                           const char *value);
+
+void
+droute_wire_open_struct   (DRouteWire *wire);
+
+/* Returns a handle to pass to droute_wire_close_array */
+gsize
+droute_wire_open_array    (DRouteWire *wire,
+                           guint       element_alignment);
+
+void
+droute_wire_close_array   (DRouteWire *wire,
+                           gsize       array);
+
+gsize
+droute_wire_get_size      (DRouteWire *wire);
+
+DBusMessage *
+droute_wire_finish        (DRouteWire *wire);
+
+#endif /* _DROUTE_WIRE_H */
@@ -26,7 +26,6 @@
 #include <stdio.h>
 
 #include "droute.h"
-#include "droute-pairhash.h"
 
 #define CHUNKS_DEFAULT (512)
 
@@ -43,6 +42,15 @@ struct _DRouteContext
     GPtrArray            *registered_paths;
 
     gchar                *introspect_string;
+
+    /* Where method calls are handled, if not on the receiving thread */
+    GMainContext         *dispatch_context;
+
+    /* NULL unless statistics are being collected */
+    DRouteStats          *stats;
+
+    DRouteCallObserver    observer;
+    void                 *observer_data;
 };
 
 struct _DRoutePath
@@ -53,8 +61,7 @@ struct _DRoutePath
     GStringChunk         *chunks;
     GPtrArray            *interfaces;
     GPtrArray            *introspection;
-    GHashTable           *methods;
-    GHashTable           *properties;
+    gchar                *introspect_body;
 
     DRouteIntrospectChildrenFunction introspect_children_cb;
     void *introspect_children_data;
@@ -64,11 +71,22 @@ struct _DRoutePath
 
 /*---------------------------------------------------------------------------*/
 
-typedef struct PropertyPair
+/*
+ * The method and property dispatch tables for one interface on a path.
+ *
+ * Interfaces are kept sorted by name in DRoutePath->interfaces and the
+ * methods and properties of each interface are kept sorted by member name,
+ * so resolving an incoming (interface, member) pair is two binary searches
+ * with no hashing of either string. Properties.GetAll walks the property
+ * array of the requested interface only, emitting the dictionary in a
+ * stable order.
+ */
+typedef struct _DRouteInterface
 {
-    DRoutePropertyFunction get;
-    DRoutePropertyFunction set;
-} PropertyPair;
+    const gchar *name;
+    GArray      *methods;
+    GArray      *properties;
+} DRouteInterface;
 
 /*---------------------------------------------------------------------------*/
 
@@ -80,6 +98,109 @@ droute_object_does_not_exist_error (DBusMessage *message);
 
 /*---------------------------------------------------------------------------*/
 
+static void
+interface_free (DRouteInterface *itf)
+{
+    g_array_free (itf->methods, TRUE);
+    g_array_free (itf->properties, TRUE);
+    g_free (itf);
+}
+
+static gint
+interface_compare (gconstpointer a, gconstpointer b)
+{
+    const DRouteInterface *ia = *(const DRouteInterface **) a;
+    const DRouteInterface *ib = *(const DRouteInterface **) b;
+
+    return strcmp (ia->name, ib->name);
+}
+
+static gint
+method_compare (gconstpointer a, gconstpointer b)
+{
+    const DRouteMethod *ma = (const DRouteMethod *) a;
+    const DRouteMethod *mb = (const DRouteMethod *) b;
+
+    return strcmp (ma->name, mb->name);
+}
+
+static gint
+property_compare (gconstpointer a, gconstpointer b)
+{
+    const DRouteProperty *pa = (const DRouteProperty *) a;
+    const DRouteProperty *pb = (const DRouteProperty *) b;
+
+    return strcmp (pa->name, pb->name);
+}
+
+static DRouteInterface *
+path_lookup_interface (DRoutePath *path, const gchar *name)
+{
+    guint lo = 0;
+    guint hi = path->interfaces->len;
+
+    while (lo < hi)
+      {
+        guint mid = (lo + hi) / 2;
+        DRouteInterface *itf = g_ptr_array_index (path->interfaces, mid);
+        gint cmp = strcmp (name, itf->name);
+
+        if (cmp == 0)
+            return itf;
+        else if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+      }
+    return NULL;
+}
+
+static DRouteMethod *
+interface_lookup_method (DRouteInterface *itf, const gchar *member)
+{
+    guint lo = 0;
+    guint hi = itf->methods->len;
+
+    while (lo < hi)
+      {
+        guint mid = (lo + hi) / 2;
+        DRouteMethod *method = &g_array_index (itf->methods, DRouteMethod, mid);
+        gint cmp = strcmp (member, method->name);
+
+        if (cmp == 0)
+            return method;
+        else if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+      }
+    return NULL;
+}
+
+static DRouteProperty *
+interface_lookup_property (DRouteInterface *itf, const gchar *member)
+{
+    guint lo = 0;
+    guint hi = itf->properties->len;
+
+    while (lo < hi)
+      {
+        guint mid = (lo + hi) / 2;
+        DRouteProperty *prop = &g_array_index (itf->properties, DRouteProperty, mid);
+        gint cmp = strcmp (member, prop->name);
+
+        if (cmp == 0)
+            return prop;
+        else if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+      }
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+
 static DRoutePath *
 path_new (DRouteContext *cnx,
           const char *path,
@@ -96,19 +217,9 @@ path_new (DRouteContext *cnx,
     new_path->path = g_strdup (path);
     new_path->prefix = prefix;
     new_path->chunks = g_string_chunk_new (CHUNKS_DEFAULT);
-    new_path->interfaces = g_ptr_array_new ();
+    new_path->interfaces = g_ptr_array_new_with_free_func ((GDestroyNotify) interface_free);
     new_path->introspection = g_ptr_array_new ();
 
-    new_path->methods = g_hash_table_new_full ((GHashFunc)str_pair_hash,
-                                               str_pair_equal,
-                                               g_free,
-                                               NULL);
-
-    new_path->properties = g_hash_table_new_full ((GHashFunc)str_pair_hash,
-                                                  str_pair_equal,
-                                                  g_free,
-                                                  g_free);
-
     new_path->introspect_children_cb = introspect_children_cb;
     new_path->introspect_children_data = introspect_children_data;
     new_path->user_data = user_data;
@@ -124,18 +235,28 @@ path_free (DRoutePath *path, gpointer user_data)
     g_string_chunk_free  (path->chunks);
     g_ptr_array_free     (path->interfaces, TRUE);
     g_free(g_ptr_array_free     (path->introspection, FALSE));
-    g_hash_table_destroy (path->methods);
-    g_hash_table_destroy (path->properties);
+    g_free (path->introspect_body);
     g_free (path);
 }
 
 static void *
 path_get_datum (DRoutePath *path, const gchar *pathstr)
 {
-    if (path->get_datum != NULL)
-        return (path->get_datum) (pathstr, path->user_data);
-    else
+    if (path->get_datum == NULL)
         return path->user_data;
+
+    if (G_UNLIKELY (path->cnx->stats != NULL))
+      {
+        gint64 start = g_get_monotonic_time ();
+        void *datum = (path->get_datum) (pathstr, path->user_data);
+
+        if (path->cnx->stats)
+            droute_stats_record (path->cnx->stats, DROUTE_STATS_DATUM, path->path,
+                                 g_get_monotonic_time () - start);
+        return datum;
+      }
+
+    return (path->get_datum) (pathstr, path->user_data);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -156,6 +277,10 @@ droute_free (DRouteContext *cnx)
 {
     g_ptr_array_foreach (cnx->registered_paths, (GFunc) path_free, NULL);
     g_ptr_array_free (cnx->registered_paths, TRUE);
+    if (cnx->dispatch_context)
+        g_main_context_unref (cnx->dispatch_context);
+    if (cnx->stats)
+        droute_stats_free (cnx->stats);
     g_free (cnx);
 }
 
@@ -210,40 +335,90 @@ droute_path_add_interface(DRoutePath *path,
                           const DRouteMethod   *methods,
                           const DRouteProperty *properties)
 {
+    DRouteInterface *interface;
     gchar *itf;
 
     g_return_if_fail (name != NULL);
 
     itf = g_string_chunk_insert (path->chunks, name);
-    g_ptr_array_add (path->interfaces, itf);
     g_ptr_array_add (path->introspection, (gpointer) introspect);
+    g_free (path->introspect_body);
+    path->introspect_body = NULL;
+
+    interface = path_lookup_interface (path, itf);
+    if (!interface)
+      {
+        interface = g_new0 (DRouteInterface, 1);
+        interface->name = itf;
+        interface->methods = g_array_new (FALSE, FALSE, sizeof (DRouteMethod));
+        interface->properties = g_array_new (FALSE, FALSE, sizeof (DRouteProperty));
+        g_ptr_array_add (path->interfaces, interface);
+        g_ptr_array_sort (path->interfaces, interface_compare);
+      }
 
     for (; methods != NULL && methods->name != NULL; methods++)
       {
-        gchar *meth;
+        DRouteMethod method;
 
-        meth = g_string_chunk_insert (path->chunks, methods->name);
-        g_hash_table_insert (path->methods, str_pair_new (itf, meth), methods->func);
+        method.func = methods->func;
+        method.name = g_string_chunk_insert (path->chunks, methods->name);
+        method.signature = methods->signature ?
+            g_string_chunk_insert_const (path->chunks, methods->signature) : NULL;
+        g_array_append_val (interface->methods, method);
       }
+    g_array_sort (interface->methods, method_compare);
 
     for (; properties != NULL && properties->name != NULL; properties++)
       {
-        gchar *prop;
-        PropertyPair *pair;
-
-        prop = g_string_chunk_insert (path->chunks, properties->name);
-        pair = g_new (PropertyPair, 1);
-        pair->get = properties->get;
-        pair->set = properties->set;
-        g_hash_table_insert (path->properties, str_pair_new (itf, prop), pair);
+        DRouteProperty prop;
+
+        prop.get = properties->get;
+        prop.set = properties->set;
+        prop.name = g_string_chunk_insert (path->chunks, properties->name);
+        g_array_append_val (interface->properties, prop);
       }
+    g_array_sort (interface->properties, property_compare);
 }
 
-/*---------------------------------------------------------------------------*/
+static DRouteMethod *
+path_lookup_method (DRoutePath  *path,
+                    const gchar *iface,
+                    const gchar *member)
+{
+    DRouteInterface *interface;
+
+    interface = path_lookup_interface (path, iface);
+    if (!interface)
+        return NULL;
+
+    return interface_lookup_method (interface, member);
+}
 
-/* The data structures don't support an efficient implementation of GetAll
- * and I don't really care.
+/*
+ * Compares the arguments of a call against the signature the method
+ * was registered with, so that handlers may read them without checking
+ * their types. Methods registered without a signature accept anything.
  */
+static gboolean
+method_accepts (const DRouteMethod *method, DBusMessage *message)
+{
+    return method->signature == NULL ||
+           strcmp (method->signature, dbus_message_get_signature (message)) == 0;
+}
+
+DRouteFunction
+droute_path_get_method (DRoutePath  *path,
+                        const char  *iface,
+                        const char  *member)
+{
+    DRouteMethod *method;
+
+    method = path_lookup_method (path, iface, member);
+    return method ? method->func : NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+
 static DBusMessage *
 impl_prop_GetAll (DBusMessage *message,
                   DRoutePath  *path,
@@ -252,11 +427,9 @@ impl_prop_GetAll (DBusMessage *message,
     DBusMessageIter iter, iter_dict, iter_dict_entry;
     DBusMessage *reply;
     DBusError error;
-    GHashTableIter prop_iter;
-
-    StrPair *key;
-    PropertyPair *value;
+    DRouteInterface *interface;
     gchar *iface;
+    guint i;
 
     void  *datum = path_get_datum (path, pathstr);
     if (!datum)
@@ -281,22 +454,22 @@ impl_prop_GetAll (DBusMessage *message,
                 (&iter, DBUS_TYPE_ARRAY, "{sv}", &iter_dict))
         oom ();
 
-    g_hash_table_iter_init (&prop_iter, path->properties);
-    while (g_hash_table_iter_next (&prop_iter, (gpointer*)&key, (gpointer*)&value))
+    interface = path_lookup_interface (path, iface);
+    for (i = 0; interface && i < interface->properties->len; i++)
       {
-        if (!g_strcmp0 (key->one, iface))
-         {
-           if (!value->get)
-              continue;
-           if (!dbus_message_iter_open_container
-                        (&iter_dict, DBUS_TYPE_DICT_ENTRY, NULL, &iter_dict_entry))
-              oom ();
-           dbus_message_iter_append_basic (&iter_dict_entry, DBUS_TYPE_STRING,
-                                           &key->two);
-           (value->get) (&iter_dict_entry, datum);
-           if (!dbus_message_iter_close_container (&iter_dict, &iter_dict_entry))
-               oom ();
-         }
+        DRouteProperty *prop = &g_array_index (interface->properties,
+                                               DRouteProperty, i);
+
+        if (!prop->get)
+           continue;
+        if (!dbus_message_iter_open_container
+                     (&iter_dict, DBUS_TYPE_DICT_ENTRY, NULL, &iter_dict_entry))
+           oom ();
+        dbus_message_iter_append_basic (&iter_dict_entry, DBUS_TYPE_STRING,
+                                        &prop->name);
+        (prop->get) (&iter_dict_entry, datum);
+        if (!dbus_message_iter_close_container (&iter_dict, &iter_dict_entry))
+            oom ();
       }
 
     if (!dbus_message_iter_close_container (&iter, &iter_dict))
@@ -313,8 +486,9 @@ impl_prop_GetSet (DBusMessage *message,
     DBusMessage *reply = NULL;
     DBusError error;
 
-    StrPair pair;
-    PropertyPair *prop_funcs = NULL;
+    const gchar *iface, *member;
+    DRouteInterface *interface;
+    DRouteProperty *prop_funcs = NULL;
 
     void *datum;
 
@@ -322,19 +496,22 @@ impl_prop_GetSet (DBusMessage *message,
     if (!dbus_message_get_args (message,
                                 &error,
                                 DBUS_TYPE_STRING,
-                                &(pair.one),
+                                &iface,
                                 DBUS_TYPE_STRING,
-                                &(pair.two),
+                                &member,
                                 DBUS_TYPE_INVALID))
       {
         DBusMessage *ret;
         ret = dbus_message_new_error (message, DBUS_ERROR_FAILED, error.message);
         dbus_error_free (&error);
+        return ret;
       }
 
-    _DROUTE_DEBUG ("DRoute (handle prop): %s|%s on %s\n", pair.one, pair.two, pathstr);
+    _DROUTE_DEBUG ("DRoute (handle prop): %s|%s on %s\n", iface, member, pathstr);
 
-    prop_funcs = (PropertyPair *) g_hash_table_lookup (path->properties, &pair);
+    interface = path_lookup_interface (path, iface);
+    if (interface)
+        prop_funcs = interface_lookup_property (interface, member);
     if (!prop_funcs)
       {
         DBusMessage *ret;
@@ -356,7 +533,7 @@ impl_prop_GetSet (DBusMessage *message,
         
         DBusMessageIter iter;
 
-        _DROUTE_DEBUG ("DRoute (handle prop Get): %s|%s on %s\n", pair.one, pair.two, pathstr);
+        _DROUTE_DEBUG ("DRoute (handle prop Get): %s|%s on %s\n", iface, member, pathstr);
 
         reply = dbus_message_new_method_return (message);
         dbus_message_iter_init_append (reply, &iter);
@@ -370,7 +547,7 @@ impl_prop_GetSet (DBusMessage *message,
       {
         DBusMessageIter iter;
 
-        _DROUTE_DEBUG ("DRoute (handle prop Get): %s|%s on %s\n", pair.one, pair.two, pathstr);
+        _DROUTE_DEBUG ("DRoute (handle prop Get): %s|%s on %s\n", iface, member, pathstr);
 
         dbus_message_iter_init (message, &iter);
         /* Skip the interface and property name */
@@ -423,6 +600,36 @@ handle_dbus (DBusConnection *bus,
     return DBUS_HANDLER_RESULT_HANDLED;
 }
 
+/*
+ * Property access is recorded against the interface and property asked
+ * for, as "Get Name", "Set Name" or "GetAll", rather than against
+ * org.freedesktop.DBus.Properties.
+ */
+static void
+record_properties_stats (DRouteStats *stats,
+                         DBusMessage *message,
+                         const gchar *member,
+                         gint64       elapsed)
+{
+    const gchar *iface = NULL;
+    const gchar *name = NULL;
+    gchar *key;
+
+    if (!dbus_message_get_args (message, NULL,
+                                DBUS_TYPE_STRING, &iface,
+                                DBUS_TYPE_INVALID))
+        return;
+    if (g_strcmp0 (member, "GetAll") != 0)
+        dbus_message_get_args (message, NULL,
+                               DBUS_TYPE_STRING, &iface,
+                               DBUS_TYPE_STRING, &name,
+                               DBUS_TYPE_INVALID);
+
+    key = name ? g_strconcat (member, " ", name, NULL) : g_strdup (member);
+    droute_stats_record (stats, iface, key, elapsed);
+    g_free (key);
+}
+
 static DBusHandlerResult
 handle_properties (DBusConnection *bus,
                    DBusMessage    *message,
@@ -433,6 +640,10 @@ handle_properties (DBusConnection *bus,
 {
     DBusMessage *reply = NULL;
     DBusHandlerResult result = DBUS_HANDLER_RESULT_HANDLED;
+    gint64 start = 0;
+
+    if (G_UNLIKELY (path->cnx->stats != NULL))
+        start = g_get_monotonic_time ();
 
     if (!g_strcmp0(member, "GetAll"))
        reply = impl_prop_GetAll (message, path, pathstr);
@@ -449,6 +660,11 @@ handle_properties (DBusConnection *bus,
         dbus_message_unref (reply);
       }
 
+    /* The call may have turned statistics off */
+    if (G_UNLIKELY (start != 0) && path->cnx->stats)
+        record_properties_stats (path->cnx->stats, message, member,
+                                 g_get_monotonic_time () - start);
+
     return result;
 }
 
@@ -463,6 +679,29 @@ static const char *introspection_node_element =
 static const char *introspection_footer =
 "</node>";
 
+/*
+ * The interface part of the introspection data only changes when an
+ * interface is added to the path, so it is concatenated once and reused
+ * for every Introspect call on any object under the path.
+ */
+static const gchar *
+path_get_introspect_body (DRoutePath *path)
+{
+    if (!path->introspect_body)
+      {
+        GString *body = g_string_new ("");
+        gint i;
+
+        for (i=0; i < path->introspection->len; i++)
+          {
+            gchar *introspect = (gchar *) g_ptr_array_index (path->introspection, i);
+            g_string_append (body, introspect);
+          }
+        path->introspect_body = g_string_free (body, FALSE);
+      }
+    return path->introspect_body;
+}
+
 static DBusHandlerResult
 handle_introspection (DBusConnection *bus,
                       DBusMessage    *message,
@@ -473,7 +712,8 @@ handle_introspection (DBusConnection *bus,
 {
     GString *output;
     gchar *final;
-    gint i;
+    gchar *children = NULL;
+    const gchar *body = "";
 
     DBusMessage *reply;
 
@@ -482,30 +722,27 @@ handle_introspection (DBusConnection *bus,
     if (g_strcmp0 (member, "Introspect"))
         return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 
-    output = g_string_new(introspection_header);
-
-    g_string_append_printf(output, introspection_node_element, pathstr);
-
     if (!path->get_datum || path_get_datum (path, pathstr))
-      {
-        for (i=0; i < path->introspection->len; i++)
-          {
-            gchar *introspect = (gchar *) g_ptr_array_index (path->introspection, i);
-            g_string_append (output, introspect);
-          }
-      }
+        body = path_get_introspect_body (path);
 
     if (path->introspect_children_cb)
+        children = (*path->introspect_children_cb) (pathstr, path->introspect_children_data);
+
+    output = g_string_sized_new (strlen (introspection_header) +
+                                 strlen (introspection_node_element) +
+                                 strlen (pathstr) +
+                                 strlen (body) +
+                                 (children ? strlen (children) : 0) +
+                                 strlen (introspection_footer));
+    g_string_append (output, introspection_header);
+    g_string_append_printf (output, introspection_node_element, pathstr);
+    g_string_append (output, body);
+    if (children)
       {
-        gchar *children = (*path->introspect_children_cb) (pathstr, path->introspect_children_data);
-        if (children)
-          {
-            g_string_append (output, children);
-            g_free (children);
-          }
+        g_string_append (output, children);
+        g_free (children);
       }
-
-    g_string_append(output, introspection_footer);
+    g_string_append (output, introspection_footer);
     final = g_string_free(output, FALSE);
 
     reply = dbus_message_new_method_return (message);
@@ -532,29 +769,31 @@ handle_other (DBusConnection *bus,
 {
     gint result = DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 
-    StrPair pair;
-    DRouteFunction func;
+    DRouteMethod *method;
     DBusMessage *reply = NULL;
 
     void *datum;
 
-    pair.one = iface;
-    pair.two = member;
-
     _DROUTE_DEBUG ("DRoute (handle other): %s|%s on %s\n", member, iface, pathstr);
 
-    func = (DRouteFunction) g_hash_table_lookup (path->methods, &pair);
-    if (func != NULL)
+    method = path_lookup_method (path, iface, member);
+    if (method != NULL)
       {
-        datum = path_get_datum (path, pathstr);
-        if (!datum)
+        gint64 start = 0;
+
+        if (G_UNLIKELY (path->cnx->stats != NULL))
+            start = g_get_monotonic_time ();
+
+        if (!method_accepts (method, message))
+            reply = droute_invalid_arguments_error (message);
+        else if (!(datum = path_get_datum (path, pathstr)))
 	    reply = droute_object_does_not_exist_error (message);
         else
-            reply = (func) (bus, message, datum);
+            reply = (method->func) (bus, message, datum);
 
         /* All D-Bus method calls must have a reply.
          * If one is not provided presume that the caller has already
-         * sent one.
+         * sent one, or will send one through a DRoutePendingReply.
          */
         if (reply)
           {
@@ -562,6 +801,13 @@ handle_other (DBusConnection *bus,
             dbus_message_unref (reply);
           }
         result = DBUS_HANDLER_RESULT_HANDLED;
+
+        /* Deferred replies are only timed up to the first slice. The
+         * call may have been Stats.SetEnabled, turning statistics off.
+         */
+        if (G_UNLIKELY (start != 0) && path->cnx->stats)
+            droute_stats_record (path->cnx->stats, iface, member,
+                                 g_get_monotonic_time () - start);
       }
 
     _DROUTE_DEBUG ("DRoute (handle other) (reply): type %d\n",
@@ -572,24 +818,14 @@ handle_other (DBusConnection *bus,
 /*---------------------------------------------------------------------------*/
 
 static DBusHandlerResult
-handle_message (DBusConnection *bus, DBusMessage *message, void *user_data)
+dispatch_message (DBusConnection *bus, DBusMessage *message, DRoutePath *path)
 {
-    DRoutePath *path = (DRoutePath *) user_data;
     const gchar *iface   = dbus_message_get_interface (message);
     const gchar *member  = dbus_message_get_member (message);
-    const gint   type    = dbus_message_get_type (message);
     const gchar *pathstr = dbus_message_get_path (message);
 
     DBusHandlerResult result = DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 
-    _DROUTE_DEBUG ("DRoute (handle message): %s|%s of type %d on %s\n", member, iface, type, pathstr);
-
-    /* Check for basic reasons not to handle */
-    if (type   != DBUS_MESSAGE_TYPE_METHOD_CALL ||
-        member == NULL ||
-        iface  == NULL)
-        return result;
-
     if (!strcmp (pathstr, DBUS_PATH_DBUS))
         result = handle_dbus (bus, message, iface, member, pathstr);
     else if (!strcmp (iface, "org.freedesktop.DBus.Properties"))
@@ -598,14 +834,581 @@ handle_message (DBusConnection *bus, DBusMessage *message, void *user_data)
         result = handle_introspection (bus, message, path, iface, member, pathstr);
     else
         result = handle_other (bus, message, path, iface, member, pathstr);
+
+    /* The D-Bus interception has no path */
+    if (result == DBUS_HANDLER_RESULT_HANDLED &&
+        strcmp (pathstr, DBUS_PATH_DBUS) != 0 && path->cnx->observer)
+        (path->cnx->observer) (bus, message, path->cnx->observer_data);
 #if 0
     if (result == DBUS_HANDLER_RESULT_NOT_YET_HANDLED)
-        g_print ("DRoute | Unhandled message: %s|%s of type %d on %s\n", member, iface, type, pathstr);
+        g_print ("DRoute | Unhandled message: %s|%s on %s\n", member, iface, pathstr);
 #endif
-      
+
     return result;
 }
 
+/*
+ * A method call received on one thread and handled on the
+ * dispatch context of the DRouteContext.
+ */
+typedef struct _DRouteDispatch
+{
+    DBusConnection *bus;
+    DBusMessage    *message;
+    DRoutePath     *path;
+} DRouteDispatch;
+
+static gboolean
+dispatch_on_context (gpointer data)
+{
+    DRouteDispatch *dispatch = (DRouteDispatch *) data;
+
+    /* The receiving thread has already claimed the message, so
+     * it must be answered here.
+     */
+    if (dispatch_message (dispatch->bus, dispatch->message, dispatch->path) ==
+        DBUS_HANDLER_RESULT_NOT_YET_HANDLED)
+      {
+        DBusMessage *reply = droute_not_yet_handled_error (dispatch->message);
+
+        dbus_connection_send (dispatch->bus, reply, NULL);
+        dbus_message_unref (reply);
+      }
+
+    dbus_message_unref (dispatch->message);
+    dbus_connection_unref (dispatch->bus);
+    g_free (dispatch);
+    return FALSE;
+}
+
+static DBusHandlerResult
+handle_message (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DRoutePath *path = (DRoutePath *) user_data;
+    const gchar *iface   = dbus_message_get_interface (message);
+    const gchar *member  = dbus_message_get_member (message);
+    const gint   type    = dbus_message_get_type (message);
+    const gchar *pathstr = dbus_message_get_path (message);
+    GMainContext *context = NULL;
+
+    _DROUTE_DEBUG ("DRoute (handle message): %s|%s of type %d on %s\n", member, iface, type, pathstr);
+
+    /* Check for basic reasons not to handle */
+    if (type   != DBUS_MESSAGE_TYPE_METHOD_CALL ||
+        member == NULL ||
+        iface  == NULL)
+        return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+
+    if (path)
+        context = g_atomic_pointer_get (&path->cnx->dispatch_context);
+
+    if (context && strcmp (pathstr, DBUS_PATH_DBUS) != 0)
+      {
+        DRouteDispatch *dispatch;
+        GSource *source;
+
+        /* Reject calls to unknown methods, or with the wrong arguments,
+         * without involving the dispatch context. The tables are not
+         * modified once the paths are registered, so they may be read
+         * from here.
+         */
+        if (strcmp (iface, "org.freedesktop.DBus.Properties") != 0 &&
+            strcmp (iface, "org.freedesktop.DBus.Introspectable") != 0)
+          {
+            DRouteMethod *method = path_lookup_method (path, iface, member);
+
+            if (!method)
+                return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+            if (!method_accepts (method, message))
+              {
+                DBusMessage *reply = droute_invalid_arguments_error (message);
+
+                dbus_connection_send (bus, reply, NULL);
+                dbus_message_unref (reply);
+                return DBUS_HANDLER_RESULT_HANDLED;
+              }
+          }
+
+        dispatch = g_new (DRouteDispatch, 1);
+        dispatch->bus = dbus_connection_ref (bus);
+        dispatch->message = dbus_message_ref (message);
+        dispatch->path = path;
+
+        source = g_idle_source_new ();
+        g_source_set_priority (source, G_PRIORITY_DEFAULT);
+        g_source_set_callback (source, dispatch_on_context, dispatch, NULL);
+        g_source_attach (source, context);
+        g_source_unref (source);
+        return DBUS_HANDLER_RESULT_HANDLED;
+      }
+
+    return dispatch_message (bus, message, path);
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * The batch interface executes a vector of (path, interface, member, args)
+ * calls against the same dispatch tables used for ordinary messages and
+ * returns one (error name, values) result per call, the error name being
+ * empty on success. This saves an AT one round-trip per call when it
+ * needs many small pieces of information at once.
+ *
+ * Each call is dispatched as a synthetic method call carrying the sender
+ * and serial of the Batch message, so a handler must not send a reply
+ * of its own: it would answer the Batch call. Methods flagged
+ * DROUTE_METHOD_SENDS_REPLY get an error result instead, and deferred
+ * replies are run to completion on the spot and captured.
+ */
+
+#define DROUTE_BATCH_CALL_SIGNATURE "a(ossav)"
+
+static const char *droute_batch_introspection =
+"<interface name=\"" DROUTE_BATCH_INTERFACE "\">\n"
+"  <method name=\"Call\">\n"
+"    <arg direction=\"in\" name=\"calls\" type=\"" DROUTE_BATCH_CALL_SIGNATURE "\"/>\n"
+"    <arg direction=\"out\" name=\"results\" type=\"a(sav)\"/>\n"
+"  </method>\n"
+"</interface>\n";
+
+/*
+ * Finds the registered path that would receive a message sent to pathstr,
+ * preferring the most specific match as libdbus does for fallbacks.
+ */
+static DRoutePath *
+context_lookup_path (DRouteContext *cnx, const gchar *pathstr)
+{
+    DRoutePath *best = NULL;
+    gsize best_len = 0;
+    guint i;
+
+    for (i = 0; i < cnx->registered_paths->len; i++)
+      {
+        DRoutePath *path = g_ptr_array_index (cnx->registered_paths, i);
+        gsize len = strlen (path->path);
+
+        if (path->prefix)
+          {
+            if (strncmp (pathstr, path->path, len) != 0 ||
+                (pathstr[len] != '/' && pathstr[len] != '\0'))
+                continue;
+          }
+        else if (strcmp (pathstr, path->path) != 0)
+            continue;
+
+        if (!best || len > best_len)
+          {
+            best = path;
+            best_len = len;
+          }
+      }
+    return best;
+}
+
+static void
+batch_copy_iter (DBusMessageIter *src, DBusMessageIter *dest);
+
+/*
+ * Copies the value at src to dest, recursing into containers.
+ */
+static void
+batch_copy_value (DBusMessageIter *src, DBusMessageIter *dest)
+{
+    int type = dbus_message_iter_get_arg_type (src);
+    DBusMessageIter src_sub, dest_sub;
+    char *sig = NULL;
+
+    switch (type)
+      {
+      case DBUS_TYPE_ARRAY:
+      case DBUS_TYPE_VARIANT:
+      case DBUS_TYPE_STRUCT:
+      case DBUS_TYPE_DICT_ENTRY:
+        dbus_message_iter_recurse (src, &src_sub);
+        if (type == DBUS_TYPE_ARRAY)
+            sig = dbus_message_iter_get_signature (src);
+        else if (type == DBUS_TYPE_VARIANT)
+            sig = dbus_message_iter_get_signature (&src_sub);
+        /* An array's signature includes the leading 'a' */
+        if (!dbus_message_iter_open_container
+                    (dest, type,
+                     sig ? (type == DBUS_TYPE_ARRAY ? sig + 1 : sig) : NULL,
+                     &dest_sub))
+            oom ();
+        batch_copy_iter (&src_sub, &dest_sub);
+        if (!dbus_message_iter_close_container (dest, &dest_sub))
+            oom ();
+        dbus_free (sig);
+        break;
+      default:
+        {
+          union
+          {
+              dbus_uint64_t u64;
+              double d;
+              const char *str;
+          } value;
+
+          dbus_message_iter_get_basic (src, &value);
+          if (!dbus_message_iter_append_basic (dest, type, &value))
+              oom ();
+        }
+        break;
+      }
+}
+
+/*
+ * Copies all remaining values from src to dest.
+ */
+static void
+batch_copy_iter (DBusMessageIter *src, DBusMessageIter *dest)
+{
+    while (dbus_message_iter_get_arg_type (src) != DBUS_TYPE_INVALID)
+      {
+        batch_copy_value (src, dest);
+        dbus_message_iter_next (src);
+      }
+}
+
+/*
+ * Dispatches one synthetic call to the handler that would have processed
+ * it had it arrived as a message of its own.
+ */
+static DBusMessage *
+batch_dispatch (DBusConnection *bus,
+                DBusMessage    *message,
+                DRoutePath     *path,
+                const gchar    *iface,
+                const gchar    *member,
+                const gchar    *pathstr)
+{
+    DRouteMethod *method;
+    DBusMessage *reply;
+    void *datum;
+
+    if (!strcmp (iface, "org.freedesktop.DBus.Properties"))
+      {
+        if (!strcmp (member, "GetAll"))
+            return impl_prop_GetAll (message, path, pathstr);
+        else if (!strcmp (member, "Get"))
+            return impl_prop_GetSet (message, path, pathstr, TRUE);
+        else if (!strcmp (member, "Set"))
+            return impl_prop_GetSet (message, path, pathstr, FALSE);
+        return droute_not_yet_handled_error (message);
+      }
+
+    /* Nested batches would recurse without bound */
+    if (!strcmp (iface, DROUTE_BATCH_INTERFACE))
+        return droute_not_yet_handled_error (message);
+
+    method = path_lookup_method (path, iface, member);
+    if (!method)
+        return droute_not_yet_handled_error (message);
+    if (!method_accepts (method, message))
+        return droute_invalid_arguments_error (message);
+
+    if (method->flags & DROUTE_METHOD_SENDS_REPLY)
+        return dbus_message_new_error (message, DBUS_ERROR_NOT_SUPPORTED,
+                                       "Method cannot be batched");
+
+    datum = path_get_datum (path, pathstr);
+    if (!datum)
+        return droute_object_does_not_exist_error (message);
+
+    droute_pending_capture_begin ();
+    reply = (method->func) (bus, message, datum);
+    if (reply)
+      {
+        /* Nothing may have been deferred if the handler replied */
+        DBusMessage *deferred = droute_pending_capture_end ();
+
+        if (deferred)
+            dbus_message_unref (deferred);
+        return reply;
+      }
+
+    reply = droute_pending_capture_end ();
+    if (!reply)
+        reply = dbus_message_new_error (message, DBUS_ERROR_FAILED,
+                                        "Method did not reply");
+    return reply;
+}
+
+static void
+batch_append_result (DBusMessageIter *iter, DBusMessage *result)
+{
+    DBusMessageIter iter_struct, iter_array, iter_result;
+    const char *error_name = "";
+
+    if (dbus_message_get_type (result) == DBUS_MESSAGE_TYPE_ERROR)
+        error_name = dbus_message_get_error_name (result);
+
+    if (!dbus_message_iter_open_container (iter, DBUS_TYPE_STRUCT, NULL,
+                                           &iter_struct))
+        oom ();
+    dbus_message_iter_append_basic (&iter_struct, DBUS_TYPE_STRING, &error_name);
+    if (!dbus_message_iter_open_container (&iter_struct, DBUS_TYPE_ARRAY, "v",
+                                           &iter_array))
+        oom ();
+
+    if (dbus_message_iter_init (result, &iter_result))
+      {
+        do
+          {
+            DBusMessageIter iter_variant;
+            char *sig = dbus_message_iter_get_signature (&iter_result);
+
+            if (!dbus_message_iter_open_container (&iter_array, DBUS_TYPE_VARIANT,
+                                                   sig, &iter_variant))
+                oom ();
+            dbus_free (sig);
+            batch_copy_value (&iter_result, &iter_variant);
+            if (!dbus_message_iter_close_container (&iter_array, &iter_variant))
+                oom ();
+          }
+        while (dbus_message_iter_next (&iter_result));
+      }
+
+    if (!dbus_message_iter_close_container (&iter_struct, &iter_array))
+        oom ();
+    if (!dbus_message_iter_close_container (iter, &iter_struct))
+        oom ();
+}
+
+/*
+ * The interface and member of an entry are plain strings, which libdbus
+ * refuses to put in a message header unless they are valid names.
+ */
+static DBusMessage *
+batch_invalid_name_error (DBusMessage *message,
+                          const char  *iface,
+                          const char  *member)
+{
+    DBusMessage *reply;
+    gchar       *errmsg;
+
+    errmsg = g_strdup_printf ("Batched call to \"%s\" on interface \"%s\" "
+                              "does not name a valid method\n",
+                              member, iface);
+    reply = dbus_message_new_error (message, DBUS_ERROR_INVALID_ARGS, errmsg);
+    g_free (errmsg);
+    return reply;
+}
+
+static DBusMessage *
+impl_batch_Call (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DRouteContext *cnx = (DRouteContext *) user_data;
+    DBusMessageIter iter, iter_calls, iter_reply, iter_results;
+    DBusMessage *reply;
+
+    reply = dbus_message_new_method_return (message);
+    if (!reply)
+        oom ();
+    dbus_message_iter_init_append (reply, &iter_reply);
+    if (!dbus_message_iter_open_container (&iter_reply, DBUS_TYPE_ARRAY, "(sav)",
+                                           &iter_results))
+        oom ();
+
+    dbus_message_iter_init (message, &iter);
+    dbus_message_iter_recurse (&iter, &iter_calls);
+    while (dbus_message_iter_get_arg_type (&iter_calls) != DBUS_TYPE_INVALID)
+      {
+        DBusMessageIter iter_struct, iter_args, iter_append;
+        const char *pathstr, *iface, *member;
+        DBusMessage *call, *result;
+        DRoutePath *path;
+
+        dbus_message_iter_recurse (&iter_calls, &iter_struct);
+        dbus_message_iter_get_basic (&iter_struct, &pathstr);
+        dbus_message_iter_next (&iter_struct);
+        dbus_message_iter_get_basic (&iter_struct, &iface);
+        dbus_message_iter_next (&iter_struct);
+        dbus_message_iter_get_basic (&iter_struct, &member);
+        dbus_message_iter_next (&iter_struct);
+        dbus_message_iter_recurse (&iter_struct, &iter_args);
+
+        _DROUTE_DEBUG ("DRoute (batch): %s|%s on %s\n", member, iface, pathstr);
+
+        if (!dbus_validate_interface (iface, NULL) ||
+            !dbus_validate_member (member, NULL))
+          {
+            result = batch_invalid_name_error (message, iface, member);
+            if (!result)
+                oom ();
+            batch_append_result (&iter_results, result);
+            dbus_message_unref (result);
+            dbus_message_iter_next (&iter_calls);
+            continue;
+          }
+
+        call = dbus_message_new_method_call (NULL, pathstr, iface, member);
+        if (!call)
+            oom ();
+        dbus_message_set_serial (call, dbus_message_get_serial (message));
+        if (dbus_message_get_sender (message))
+            dbus_message_set_sender (call, dbus_message_get_sender (message));
+
+        /* Unwrap the variants into the synthetic call's arguments */
+        dbus_message_iter_init_append (call, &iter_append);
+        while (dbus_message_iter_get_arg_type (&iter_args) != DBUS_TYPE_INVALID)
+          {
+            DBusMessageIter iter_variant;
+
+            dbus_message_iter_recurse (&iter_args, &iter_variant);
+            batch_copy_value (&iter_variant, &iter_append);
+            dbus_message_iter_next (&iter_args);
+          }
+
+        path = context_lookup_path (cnx, pathstr);
+        if (path)
+            result = batch_dispatch (bus, call, path, iface, member, pathstr);
+        else
+            result = droute_object_does_not_exist_error (call);
+        dbus_message_unref (call);
+        if (!result)
+            oom ();
+
+        batch_append_result (&iter_results, result);
+        dbus_message_unref (result);
+        dbus_message_iter_next (&iter_calls);
+      }
+
+    if (!dbus_message_iter_close_container (&iter_reply, &iter_results))
+        oom ();
+    return reply;
+}
+
+static const DRouteMethod droute_batch_methods[] = {
+    {impl_batch_Call, "Call", DROUTE_BATCH_CALL_SIGNATURE},
+    {NULL, NULL}
+};
+
+DRoutePath *
+droute_add_batch (DRouteContext *cnx,
+                  const char    *path)
+{
+    DRoutePath *new_path;
+
+    new_path = droute_add_one (cnx, path, cnx);
+    droute_path_add_interface (new_path,
+                               DROUTE_BATCH_INTERFACE,
+                               droute_batch_introspection,
+                               droute_batch_methods,
+                               NULL);
+    return new_path;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * org.a11y.atspi.Stats reports what droute_context_set_stats_enabled
+ * has collected for the context.
+ */
+
+static const char droute_stats_introspection[] =
+"<interface name=\"" DROUTE_STATS_INTERFACE "\">\n"
+"  <method name=\"GetStats\">\n"
+"    <arg direction=\"out\" type=\"a" DROUTE_STATS_SIGNATURE "\"/>\n"
+"  </method>\n"
+"  <method name=\"SetEnabled\">\n"
+"    <arg direction=\"in\" name=\"enabled\" type=\"b\"/>\n"
+"  </method>\n"
+"  <method name=\"Reset\"/>\n"
+"</interface>\n";
+
+static DBusMessage *
+impl_stats_GetStats (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DRouteContext *cnx = (DRouteContext *) user_data;
+    DBusMessage *reply;
+    DBusMessageIter iter;
+
+    reply = dbus_message_new_method_return (message);
+    if (!reply)
+        oom ();
+    dbus_message_iter_init_append (reply, &iter);
+    if (cnx->stats)
+        droute_stats_append (cnx->stats, &iter);
+    else
+      {
+        DBusMessageIter iter_array;
+
+        dbus_message_iter_open_container (&iter, DBUS_TYPE_ARRAY,
+                                          DROUTE_STATS_SIGNATURE, &iter_array);
+        dbus_message_iter_close_container (&iter, &iter_array);
+      }
+    return reply;
+}
+
+static DBusMessage *
+impl_stats_SetEnabled (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DRouteContext *cnx = (DRouteContext *) user_data;
+    dbus_bool_t enabled;
+
+    if (!dbus_message_get_args (message, NULL, DBUS_TYPE_BOOLEAN, &enabled,
+                                DBUS_TYPE_INVALID))
+        return droute_invalid_arguments_error (message);
+
+    droute_context_set_stats_enabled (cnx, enabled);
+    return dbus_message_new_method_return (message);
+}
+
+static DBusMessage *
+impl_stats_Reset (DBusConnection *bus, DBusMessage *message, void *user_data)
+{
+    DRouteContext *cnx = (DRouteContext *) user_data;
+
+    if (cnx->stats)
+        droute_stats_reset (cnx->stats);
+    return dbus_message_new_method_return (message);
+}
+
+static const DRouteMethod droute_stats_methods[] = {
+    {impl_stats_GetStats, "GetStats", ""},
+    {impl_stats_SetEnabled, "SetEnabled", "b"},
+    {impl_stats_Reset, "Reset", ""},
+    {NULL, NULL}
+};
+
+DRoutePath *
+droute_add_stats (DRouteContext *cnx,
+                  const char    *path)
+{
+    DRoutePath *new_path;
+
+    new_path = droute_add_one (cnx, path, cnx);
+    droute_path_add_interface (new_path,
+                               DROUTE_STATS_INTERFACE,
+                               droute_stats_introspection,
+                               droute_stats_methods,
+                               NULL);
+    return new_path;
+}
+
+/*
+ * Statistics are off by default; while they are, the dispatch paths only
+ * pay for a NULL check. Disabling them discards what was collected.
+ */
+void
+droute_context_set_stats_enabled (DRouteContext *cnx, gboolean enabled)
+{
+    if (enabled && !cnx->stats)
+        cnx->stats = droute_stats_new ();
+    else if (!enabled && cnx->stats)
+      {
+        droute_stats_free (cnx->stats);
+        cnx->stats = NULL;
+      }
+}
+
+DRouteStats *
+droute_context_get_stats (DRouteContext *cnx)
+{
+    return cnx->stats;
+}
+
 /*---------------------------------------------------------------------------*/
 
 static DBusMessage *
@@ -726,6 +1529,38 @@ droute_context_deregister (DRouteContext *cnx, DBusConnection *bus)
                          bus);
 }
 
+/*
+ * Makes method calls be handled on the given main context rather than on
+ * the thread that reads them from the connection. Pass NULL to handle
+ * them where they are received.
+ */
+void
+droute_context_set_dispatch_context (DRouteContext *cnx, GMainContext *context)
+{
+    GMainContext *old;
+
+    if (context)
+        g_main_context_ref (context);
+    old = g_atomic_pointer_get (&cnx->dispatch_context);
+    g_atomic_pointer_set (&cnx->dispatch_context, context);
+    if (old)
+        g_main_context_unref (old);
+}
+
+/*
+ * Sets a function to be told of every method call handled on the
+ * context's paths, once its reply has been sent or deferred. It runs
+ * where method calls are dispatched.
+ */
+void
+droute_context_set_call_observer (DRouteContext      *cnx,
+                                  DRouteCallObserver  func,
+                                  void               *data)
+{
+    cnx->observer = func;
+    cnx->observer_data = data;
+}
+
 void
 droute_intercept_dbus (DBusConnection *bus)
 {
@@ -27,7 +27,12 @@
 #include <glib.h>
 
 #include <droute/droute-variant.h>
+#include <droute/droute-pending.h>
+#include <droute/droute-stats.h>
+#include <droute/droute-wire.h>
 
+#define DROUTE_BATCH_INTERFACE "org.a11y.atspi.Batch"
+#define DROUTE_STATS_INTERFACE "org.a11y.atspi.Stats"
 
 typedef DBusMessage *(*DRouteFunction)         (DBusConnection *, DBusMessage *, void *);
 typedef dbus_bool_t  (*DRoutePropertyFunction) (DBusMessageIter *, void *);
@@ -35,13 +40,23 @@ typedef gchar *(*DRouteIntrospectChildrenFunction) (const char *, void *);
 
 typedef void        *(*DRouteGetDatumFunction) (const char *, void *);
 
+/* Told of every method call on a registered path, after it is handled */
+typedef void         (*DRouteCallObserver)     (DBusConnection *, DBusMessage *, void *);
+
 typedef struct _DRouteMethod DRouteMethod;
 struct _DRouteMethod
 {
     DRouteFunction func;
     const char *name;
+    /* Expected argument signature, or NULL to leave checking to func */
+    const char *signature;
+    /* DROUTE_METHOD_* flags */
+    guint flags;
 };
 
+/* func sends its reply itself and returns NULL, so it cannot be batched */
+#define DROUTE_METHOD_SENDS_REPLY (1 << 0)
+
 typedef struct _DRouteProperty DRouteProperty;
 struct _DRouteProperty
 {
@@ -77,6 +92,14 @@ droute_add_many (DRouteContext *cnx,
                  void *introspect_children_data,
                  const DRouteGetDatumFunction get_datum);
 
+DRoutePath *
+droute_add_batch (DRouteContext *cnx,
+                  const char    *path);
+
+DRoutePath *
+droute_add_stats (DRouteContext *cnx,
+                  const char    *path);
+
 void
 droute_path_add_interface (DRoutePath *path,
                            const char *name,
@@ -84,6 +107,11 @@ droute_path_add_interface (DRoutePath *path,
                            const DRouteMethod   *methods,
                            const DRouteProperty *properties);
 
+DRouteFunction
+droute_path_get_method (DRoutePath *path,
+                        const char *iface,
+                        const char *member);
+
 DBusMessage *
 droute_not_yet_handled_error   (DBusMessage *message);
 
@@ -105,6 +133,20 @@ droute_context_register (DRouteContext *cnx, DBusConnection *bus);
 void
 droute_context_unregister (DRouteContext *cnx, DBusConnection *bus);
 
+void
+droute_context_set_stats_enabled (DRouteContext *cnx, gboolean enabled);
+
+DRouteStats *
+droute_context_get_stats (DRouteContext *cnx);
+
+void
+droute_context_set_dispatch_context (DRouteContext *cnx, GMainContext *context);
+
+void
+droute_context_set_call_observer (DRouteContext      *cnx,
+                                  DRouteCallObserver  func,
+                                  void               *data);
+
 void
 droute_intercept_dbus (DBusConnection *connection);
 